@@ -0,0 +1,163 @@
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+// Includes most standard C++ libraries
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace chrono;
+
+// === Bounded blocking queue ===
+
+// What push() does when the queue is full
+enum class OverflowPolicy
+{
+    Block,          // Wait until a consumer makes room (backpressure on the producer)
+    DropOldest,     // Discard the item at the front to make room
+    DropNewest      // Discard the item being pushed
+};
+
+// Parses "block", "drop_oldest" or "drop_newest" (throws invalid_argument otherwise)
+inline OverflowPolicy parseOverflowPolicy(const string& name)
+{
+    if (name == "block") return OverflowPolicy::Block;
+    if (name == "drop_oldest") return OverflowPolicy::DropOldest;
+    if (name == "drop_newest") return OverflowPolicy::DropNewest;
+    throw invalid_argument("Unknown queue overflow policy: " + name + " (expected block, drop_oldest or drop_newest)");
+}
+
+// FIFO queue shared by any number of producer and consumer threads. Holds at
+// most capacity() items; what happens beyond that is set by the overflow
+// policy. Consumers sleep on a condition variable while the queue is empty
+// instead of polling it. After close(), pushes are refused and pops return
+// the remaining items, then report the queue as finished.
+template <typename T>
+class BoundedQueue
+{
+public:
+    // Capacity of 0 is treated as 1
+    explicit BoundedQueue(size_t capacity = 1024, OverflowPolicy policy = OverflowPolicy::Block)
+        : limit(max<size_t>(capacity, 1)), policy(policy)
+    {
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    // Changes capacity and policy (meant for startup, once the settings are loaded).
+    // Items beyond a smaller capacity stay queued; pushes wait or drop until it is met.
+    void configure(size_t capacity, OverflowPolicy overflow)
+    {
+        lock_guard<mutex> lock(stateMutex);
+        limit = max<size_t>(capacity, 1);
+        policy = overflow;
+        notFull.notify_all();
+    }
+
+    // Adds an item. Returns false if the item was not queued: the queue is
+    // closed, or it is full under DropNewest. Under DropOldest the evicted
+    // item is counted in dropped() and the push succeeds.
+    bool push(T item)
+    {
+        unique_lock<mutex> lock(stateMutex);
+        if (policy == OverflowPolicy::Block)
+        {
+            notFull.wait(lock, [&]{ return closed || items.size() < limit; });
+        }
+        if (closed) return false;
+
+        if (items.size() >= limit)
+        {
+            ++droppedItems;
+            if (policy == OverflowPolicy::DropNewest) return false;
+            while (items.size() >= limit) items.pop_front();
+        }
+        items.push_back(move(item));
+        lock.unlock();
+        notEmpty.notify_one();
+        return true;
+    }
+
+    // Waits for an item; returns false once the queue is closed and empty
+    bool pop(T& item)
+    {
+        unique_lock<mutex> lock(stateMutex);
+        notEmpty.wait(lock, [&]{ return closed || !items.empty(); });
+        return takeFront(item, lock);
+    }
+
+    // Waits up to timeout for an item; returns false if none arrived
+    template <typename Rep, typename Period>
+    bool popFor(T& item, duration<Rep, Period> timeout)
+    {
+        unique_lock<mutex> lock(stateMutex);
+        notEmpty.wait_for(lock, timeout, [&]{ return closed || !items.empty(); });
+        return takeFront(item, lock);
+    }
+
+    // Moves up to maxItems queued items to the end of out without waiting; returns how many
+    size_t drain(vector<T>& out, size_t maxItems = numeric_limits<size_t>::max())
+    {
+        unique_lock<mutex> lock(stateMutex);
+        size_t count = min(maxItems, items.size());
+        for (size_t i = 0; i < count; ++i)
+        {
+            out.push_back(move(items.front()));
+            items.pop_front();
+        }
+        lock.unlock();
+        if (count > 0) notFull.notify_all();
+        return count;
+    }
+
+    // Refuses further pushes and wakes every waiting thread
+    void close()
+    {
+        lock_guard<mutex> lock(stateMutex);
+        closed = true;
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+
+    size_t size() const
+    {
+        lock_guard<mutex> lock(stateMutex);
+        return items.size();
+    }
+
+    size_t capacity() const
+    {
+        lock_guard<mutex> lock(stateMutex);
+        return limit;
+    }
+
+    // Items discarded by DropOldest or DropNewest since startup
+    uint64_t dropped() const
+    {
+        lock_guard<mutex> lock(stateMutex);
+        return droppedItems;
+    }
+
+private:
+    // Pops the front item if there is one (stateMutex held by lock, released here)
+    bool takeFront(T& item, unique_lock<mutex>& lock)
+    {
+        if (items.empty()) return false;
+        item = move(items.front());
+        items.pop_front();
+        lock.unlock();
+        notFull.notify_one();
+        return true;
+    }
+
+    mutable mutex stateMutex;           // Guards everything below
+    condition_variable notEmpty;        // Signalled when an item is added or the queue closes
+    condition_variable notFull;         // Signalled when room is made or the queue closes
+    deque<T> items;
+    size_t limit;
+    OverflowPolicy policy;
+    uint64_t droppedItems = 0;
+    bool closed = false;
+};
+
+#endif // BOUNDED_QUEUE_H
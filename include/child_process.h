@@ -0,0 +1,38 @@
+#ifndef CHILD_PROCESS_H
+#define CHILD_PROCESS_H
+
+// Includes most standard C++ libraries
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// === Child processes ===
+
+// A process started directly, without a shell, with pipes to its stdin and stdout
+struct ChildProcess
+{
+#ifdef _WIN32
+    void* process = nullptr;    // Process handle
+    void* input = nullptr;      // Write end of the child's stdin
+    void* output = nullptr;     // Read end of the child's stdout
+#else
+    int process = -1;           // Process ID
+    int input = -1;             // Write end of the child's stdin
+    int output = -1;            // Read end of the child's stdout
+#endif
+};
+
+// Starts argv[0] (looked up on PATH) with argv as its arguments. No shell is
+// involved, so every argument reaches the program exactly as given. stdin and
+// stdout are pipes; stderr is inherited, or sent into the stdout pipe when
+// mergeStderr is set. Throws runtime_error naming `name` if it cannot start.
+ChildProcess spawnProcess(const vector<string>& argv, bool mergeStderr, const string& name);
+
+// Runs argv to completion with an empty stdin and returns its stdout, with
+// stderr mixed in unless mergeStderr is false (stderr is then inherited);
+// exitCode is set to its exit status. A process still running after
+// timeoutSeconds is killed, and runtime_error is thrown.
+string runProcess(const vector<string>& argv, int timeoutSeconds, int& exitCode, const string& name,
+                  bool mergeStderr = true);
+
+#endif // CHILD_PROCESS_H
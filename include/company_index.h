@@ -0,0 +1,95 @@
+#ifndef COMPANY_INDEX_H
+#define COMPANY_INDEX_H
+
+// Includes most standard C++ libraries
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// === In-memory company embedding index ===
+
+// One result of CompanyIndex::search()
+struct CompanyMatch
+{
+    uint32_t company;       // Row of the company in the index
+    float similarity;       // (1 + cosine) / 2, the $similarity AstraDB reports, in [0, 1]
+};
+
+// How CompanyIndex::search() finds the nearest companies
+enum class CompanyIndexMode
+{
+    Exact,      // Scan every float32 row
+    Int8,       // Scan int8-quantized rows, re-rank the best candidates exactly
+    Hnsw        // Walk an HNSW graph, re-rank the candidates exactly
+};
+
+// Parses "exact", "int8" or "hnsw" (throws invalid_argument otherwise)
+CompanyIndexMode parseCompanyIndexMode(const string& name);
+
+// Company names, tickers and embeddings, loaded once at startup from the file
+// written by scripts/company_exporter.py and searched in process. Rows are
+// normalized on load and stored as one contiguous row-major matrix, so
+// cosine similarity is a dot product. Read-only after build(); any number of
+// threads may search at once.
+class CompanyIndex
+{
+public:
+    // Loads a company embedding file (throws runtime_error if it is missing or malformed)
+    void load(const string& path);
+
+    // Prepares the search structures of a mode: int8 rows or the HNSW graph
+    void build(CompanyIndexMode mode);
+
+    // Up to k most similar companies to a query embedding of dimension() values, best first
+    vector<CompanyMatch> search(const float* query, size_t k) const;
+
+    size_t size() const { return names.size(); }
+    size_t dimension() const { return dim; }
+    const string& name(uint32_t company) const { return names[company]; }
+    const string& ticker(uint32_t company) const { return tickers[company]; }
+
+    // HNSW parameters (set before build)
+    size_t graphDegree = 16;        // Links per node and layer (twice as many on layer 0)
+    size_t buildBreadth = 100;      // Candidate list size while inserting
+    size_t searchBreadth = 64;      // Candidate list size while searching
+
+private:
+    // Candidate of a graph search: distance (1 - cosine) and company
+    using Candidate = pair<float, uint32_t>;
+
+    const float* row(uint32_t company) const { return &vectors[size_t(company) * dim]; }
+
+    // Exact similarity of a normalized query to a set of companies, best k first
+    vector<CompanyMatch> rerank(const float* query, vector<uint32_t>& companies, size_t k) const;
+
+    // Scans int8 rows for the closest candidates
+    vector<uint32_t> scanInt8(const float* query, size_t count) const;
+
+    // Closest `breadth` nodes of one HNSW layer to a query, nearest first
+    vector<Candidate> searchLayer(const float* query, uint32_t entry, size_t breadth, int level,
+                                  vector<uint32_t>& visited, uint32_t mark) const;
+
+    // Picks diverse HNSW links from candidates sorted nearest first
+    vector<uint32_t> selectNeighbours(const vector<Candidate>& candidates, size_t count) const;
+
+    // Inserts company i into the HNSW graph
+    void insertNode(uint32_t i, int level, vector<uint32_t>& visited, uint32_t& mark);
+
+    vector<string> names;
+    vector<string> tickers;
+    size_t dim = 0;
+    vector<float> vectors;              // size() x dim, unit rows
+
+    CompanyIndexMode mode = CompanyIndexMode::Exact;
+
+    // Int8 mode: rows scaled to [-127, 127] and each row's scale back
+    vector<int8_t> quantized;
+    vector<float> scales;
+
+    // HNSW mode: links[node][level] lists the node's neighbours on that layer
+    vector<vector<vector<uint32_t>>> links;
+    uint32_t entryPoint = 0;
+    int topLevel = -1;
+};
+
+#endif // COMPANY_INDEX_H
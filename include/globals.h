@@ -3,6 +3,8 @@
 
 // Includes most standard C++ libraries
 #include <bits/stdc++.h>
+#include "bounded_queue.h"
+#include "url_dedup.h"
 
 using namespace std;
 using namespace chrono;
@@ -46,6 +48,36 @@ struct Config
     // If true, program will use GPU for sentiment analysis
     bool useGPU;
 
+    // Most articles the sentiment worker classifies in one batch (default 16).
+    int sentimentBatchSize;
+
+    // Articles processed at once, each matching companies and sentiment in parallel (default 4).
+    int processingWorkers;
+
+    // Most items newsQueue and companyStatusQueue hold (default 1000 each).
+    int newsQueueCapacity;
+    int statusQueueCapacity;
+
+    // What a full queue does with a new item: block (default), drop_oldest or drop_newest.
+    string queueOverflowPolicy;
+
+    // Articles scraped at once (default 16), at most scrapePerDomain (default 2) from one site,
+    // each scrape giving up after scrapeTimeoutSeconds (default 20) of wall-clock time.
+    int scrapeWorkers;
+    int scrapePerDomain;
+    int scrapeTimeoutSeconds;
+
+    // Most URLs remembered for deduplication (default 131072) and how long each is remembered
+    // (default 72 hours); when full, the oldest URLs are forgotten first.
+    int seenUrlCapacity;
+    int seenUrlTtlHours;
+
+    // Local file of company embeddings (exported from AstraDB at startup if missing).
+    string companyEmbeddingsFile;
+
+    // Company search: exact, int8 (default) or hnsw.
+    string companyIndex;
+
     // Full path to the Python interpreter to use when invoking scripts.
     string pythonInterpreter;
 
@@ -106,18 +138,14 @@ extern double balance;
 // Global ofstream to write logs to file
 extern ofstream logFile;
 
-// Mutexes to protect global queues
-extern mutex newsQueueMutex;
-extern mutex companyStatusQueueMutex;
-
-// Global queue to store parsed news items
-extern queue<NewsItem> newsQueue;
+// Global queue to store parsed news items (sized from the settings at startup)
+extern BoundedQueue<NewsItem> newsQueue;
 
-// Global set to track URLs that have already been processed
-extern set<string> seenUrls;
+// Global set to track URLs that have already been processed (sized from the settings at startup)
+extern UrlDedupSet seenUrls;
 
-// Global queue for storing company sentiment analysis results
-extern queue<CompanyStatus> companyStatusQueue;
+// Global queue for storing company sentiment analysis results (sized from the settings at startup)
+extern BoundedQueue<CompanyStatus> companyStatusQueue;
 
 // Config object to hold configuration settings, loaded from a configuration file
 extern Config cfg;
@@ -0,0 +1,109 @@
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+// Includes most standard C++ libraries
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// === Streaming JSON reader ===
+
+// What JsonReader::next() found
+enum class JsonToken
+{
+    ObjectStart,    // {
+    ObjectEnd,      // }
+    ArrayStart,     // [
+    ArrayEnd,       // ]
+    Key,            // Member name; the member's value is the next token
+    String,
+    Number,
+    True,
+    False,
+    Null,
+    End             // The whole document has been read
+};
+
+// Reads a JSON document one token at a time, in document order, without
+// building a tree. Keys and strings are returned as views into the input
+// buffer; escapes are only decoded when text() is asked for one that has
+// them. The input must outlive the reader and every view it hands out.
+// Malformed input throws runtime_error with the byte offset.
+//
+//   JsonReader reader(response);
+//   for (JsonToken t = reader.next(); t != JsonToken::End; t = reader.next())
+//       if (t == JsonToken::Key && reader.raw() == "url") ...
+class JsonReader
+{
+public:
+    explicit JsonReader(string_view input) : input(input) {}
+
+    // Reads the next token
+    JsonToken next();
+
+    // Reads the next value and everything nested in it (call after a Key, or
+    // where a value is expected); returns the value's first token
+    JsonToken skipValue();
+
+    // Key/String: the characters between the quotes, escapes not decoded.
+    // Number: the literal as written. Other tokens: empty.
+    string_view raw() const { return value; }
+
+    // Key/String: whether raw() contains backslash escapes
+    bool escaped() const { return hasEscapes; }
+
+    // Key/String with escapes decoded (UTF-8; \u escapes included)
+    string text() const;
+
+    // Number as a double (throws runtime_error if it is out of range)
+    double number() const;
+
+    // Number of objects and arrays enclosing the current position: 0 at the
+    // top level, 1 for the root's members, ... Container tokens count as
+    // inside themselves ({ and } of the root are at depth 1).
+    size_t depth() const { return containers.size() + (closedContainer ? 1 : 0); }
+
+    // Byte offset in the input just past the current token
+    size_t offset() const { return pos; }
+
+private:
+    // Reads a value starting at the current character
+    JsonToken readValue();
+
+    // Reads a string at pos (on the opening quote) into value
+    void readString();
+
+    // Reads a number at pos into value
+    void readNumber();
+
+    // Reads an expected literal (true, false, null)
+    JsonToken readLiteral(string_view word, JsonToken token);
+
+    // Skips JSON whitespace
+    void skipSpace();
+
+    [[noreturn]] void fail(const string& what) const;
+
+    // One open container: '{' or '[', and whether it has no members yet
+    struct Container
+    {
+        char type;
+        bool first;
+    };
+
+    string_view input;
+    size_t pos = 0;
+    vector<Container> containers;
+    bool expectValue = false;           // A key was read; its value comes next
+    bool rootDone = false;              // The top-level value is complete
+    bool closedContainer = false;       // The current token closed a container
+
+    string_view value;
+    bool hasEscapes = false;
+};
+
+// Decodes the escapes of a raw JSON string (as returned by JsonReader::raw())
+// and appends the text to out. Unpaired surrogates become U+FFFD.
+void appendJsonUnescaped(string_view raw, string& out);
+
+#endif // JSON_READER_H
@@ -3,13 +3,20 @@
 
 // Includes most standard C++ libraries
 #include <bits/stdc++.h>
+#include "globals.h"
 
 using namespace std;
 
 // Function to run the Python script with the given article URL and capture its output
-string getArticleText(string url);
+// (the script gives up on downloads that take longer than timeoutSeconds)
+string getArticleText(string url, int timeoutSeconds);
 
-// Function to extract news items from the raw JSON string and add them to the global queue
+// Parses the articles (title, url, published_at) of a MarketAux JSON response
+// (throws runtime_error if the response is malformed)
+vector<NewsItem> parseNewsResponse(string_view response);
+
+// Function to extract news items from the raw JSON string and queue them for scraping;
+// returns at once, each article reaches the global queue when its text has been fetched
 void extractNewsFromResponse(const string response);
 
 #endif // NEWS_PARSER_H
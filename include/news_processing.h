@@ -6,7 +6,23 @@
 
 using namespace std;
 
+// Loads the company embeddings used to match articles to companies (call before processNewsArticles)
+void loadCompanyIndex();
+
+// Totals of the processing stage since startup (times in microseconds)
+struct ProcessingStats
+{
+    uint64_t articles;          // Articles processed successfully
+    uint64_t companyMicros;     // Spent matching companies
+    uint64_t sentimentMicros;   // Spent analyzing sentiment
+    uint64_t articleMicros;     // Spent per article, both stages running side by side
+};
+
+// Snapshot of the processing stage totals
+ProcessingStats stageStatistics();
+
 // Function to process news articles and update the global company status queue
+// (runs a pool of cfg.processingWorkers threads and returns only if they do)
 void processNewsArticles();
 
 #endif // NEWS_PROCESSING_H
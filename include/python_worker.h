@@ -0,0 +1,89 @@
+#ifndef PYTHON_WORKER_H
+#define PYTHON_WORKER_H
+
+// Includes most standard C++ libraries
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// === Persistent Python worker ===
+
+// Client for a long-lived Python script built on scripts/frame_worker.py
+// (sentiment_worker.py, embedding_worker.py). The script loads its model or
+// API client once and then answers requests over its stdin/stdout.
+//
+// Requests and responses are length-prefixed frames (uint32 id, uint32 length,
+// little endian, then the payload), so article text needs no quoting. A
+// response starting with "ERROR " reports a failure. Any number of threads
+// may call request() at once; the script handles the requests that are
+// waiting together in one batch, and a reader thread hands each response back
+// to its caller by id. The process is started on first use and restarted by
+// the next request if it exits.
+class PythonWorker
+{
+public:
+    // Command line of the worker process; nothing is started yet
+    PythonWorker(string interpreter, string script, vector<string> arguments);
+
+    // Closes the worker's stdin, lets it finish and waits for it to exit
+    ~PythonWorker();
+
+    PythonWorker(const PythonWorker&) = delete;
+    PythonWorker& operator=(const PythonWorker&) = delete;
+
+    // Sends one request and blocks until the worker answers.
+    // Throws runtime_error if the worker cannot be started, exits or reports an error.
+    string request(const string& payload);
+
+private:
+    // Answer slot of one request in flight
+    struct Request
+    {
+        bool done = false;      // Set by the reader thread
+        bool failed = false;    // The worker exited before answering
+        string payload;         // Response, or the failure reason
+    };
+
+    // Launches the process and its reader thread (stateMutex held)
+    void start();
+
+    // Closes the pipes and reaps the process (stateMutex held, reader joined)
+    void closeProcess();
+
+    // Reads response frames until the worker's stdout closes
+    void readLoop();
+
+    // Writes one request frame; false if the pipe is broken
+    bool writeFrame(uint32_t id, const string& payload);
+
+    // Platform pipe primitives; false on error or end of stream
+    bool writeAll(const char* data, size_t size);
+    bool readAll(char* data, size_t size);
+
+    string interpreter;         // Python interpreter to run the worker with
+    string script;              // Path of the worker script
+    vector<string> arguments;   // Passed to the script
+    string scriptName;          // File name of the script, for messages
+
+    mutex stateMutex;                                   // Guards everything below
+    condition_variable answered;                        // Signalled when requests complete
+    unordered_map<uint32_t, shared_ptr<Request>> pending;
+    uint32_t nextId = 0;
+    bool running = false;       // Process started and its stdout still open
+    bool stopping = false;      // Set by the destructor; the exit is expected
+    thread reader;
+
+    mutex writeMutex;           // Keeps request frames whole
+
+#ifdef _WIN32
+    void* process = nullptr;    // Process handle
+    void* toWorker = nullptr;   // Write end of the worker's stdin
+    void* fromWorker = nullptr; // Read end of the worker's stdout
+#else
+    int process = -1;           // Process ID
+    int toWorker = -1;
+    int fromWorker = -1;
+#endif
+};
+
+#endif // PYTHON_WORKER_H
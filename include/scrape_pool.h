@@ -0,0 +1,65 @@
+#ifndef SCRAPE_POOL_H
+#define SCRAPE_POOL_H
+
+// Includes most standard C++ libraries
+#include <bits/stdc++.h>
+#include "globals.h"
+
+using namespace std;
+
+// === Article scraping stage ===
+
+// Host part of a URL, lower-cased ("https://www.X.com:443/a?b" -> "www.x.com")
+string urlDomain(const string& url);
+
+// Fixed pool of threads that fetch article text with getArticleText() and push
+// each finished article into newsQueue as soon as it is ready. Articles of
+// different sites are scraped side by side; at most perDomain articles of one
+// site are fetched at once, so a burst from one publisher neither hammers it
+// nor occupies every worker. Articles waiting on a busy site are passed over
+// for later ones of other sites.
+//
+// A URL is only queued once while it is waiting or being scraped, even if its
+// seenUrls entry expires or is evicted meanwhile. A URL whose scrape fails is
+// erased from seenUrls, so a later poll that lists the article retries it.
+class ScrapePool
+{
+public:
+    // Starts the worker threads
+    ScrapePool(int workers, int perDomain, int timeoutSeconds);
+
+    // Drops articles not yet started, waits for the ones in progress and joins the workers
+    ~ScrapePool();
+
+    ScrapePool(const ScrapePool&) = delete;
+    ScrapePool& operator=(const ScrapePool&) = delete;
+
+    // Queues an article (title, url and publishedAt set) for scraping; returns at once.
+    // False if the same URL is already waiting or being scraped.
+    bool submit(NewsItem item);
+
+    // Articles queued or being scraped
+    size_t pending() const;
+
+private:
+    // Takes the next article whose site has a free slot and scrapes it, until stopping
+    void workerLoop();
+
+    // Index in `waiting` of the oldest article whose site has a free slot, or -1 (stateMutex held)
+    ptrdiff_t nextRunnable() const;
+
+    int perDomain;                              // Most articles of one site scraped at once
+    int timeoutSeconds;                         // Per-article download timeout
+
+    mutable mutex stateMutex;                   // Guards everything below
+    condition_variable changed;                 // Signalled on submit, finish and stop
+    deque<pair<string, NewsItem>> waiting;      // Site and article, in submission order
+    unordered_map<string, int> active;          // Articles being scraped per site
+    unordered_set<string> inFlight;             // URLs waiting or being scraped
+    size_t inProgress = 0;
+    bool stopping = false;
+
+    vector<thread> threads;
+};
+
+#endif // SCRAPE_POOL_H
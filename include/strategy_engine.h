@@ -0,0 +1,126 @@
+#ifndef STRATEGY_ENGINE_H
+#define STRATEGY_ENGINE_H
+
+// Includes standard C++ libraries
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// === Strategy engine ===
+//
+// The trading rules shared by the live trader (executeInvestmentStrategy) and
+// the simulator (simulate, simulateBatch). A strategy is a StrategyEngine
+// instantiated with one policy type per rule, so each variant is compiled into
+// its own inlined code path with no virtual calls in the event loop.
+//
+// Entry policy:  bool opens(double sentiment) const
+// Exit policy:   bool closes(double sentiment) const
+//                int64_t expiry(int64_t buyTime) const  (forced-sell time)
+// Sizing policy: double cash(double balance) const      (amount to invest)
+//
+// Exit policies used by the price timeline kernel (simulateTimeline) also give
+// price levels at which a position is closed as prices tick:
+//                double stopPrice(double buyPrice) const   (close at or below)
+//                double targetPrice(double buyPrice) const (close at or above)
+
+// What a strategy does with one news event
+enum class StrategyAction
+{
+    Ignore,     // Company match below the similarity threshold
+    Sell,       // Close every position in the company
+    Buy,        // Open a new position
+    Hold        // Sentiment between both thresholds
+};
+
+// Buys when sentiment reaches a threshold
+struct SentimentEntry
+{
+    double buyThreshold;    // Minimum sentiment score to trigger a buy
+
+    bool opens(double sentiment) const { return sentiment >= buyThreshold; }
+};
+
+// Sells on negative sentiment, otherwise after a fixed holding period
+struct SentimentExit
+{
+    double sellThreshold;   // Maximum sentiment score to trigger a sell
+    int holdSeconds;        // Time to hold a position before the forced sell
+
+    bool closes(double sentiment) const { return sentiment <= sellThreshold; }
+    int64_t expiry(int64_t buyTime) const { return buyTime + holdSeconds; }
+};
+
+// SentimentExit plus stop-loss and take-profit levels relative to the buy price.
+// A fraction of 0 disables that level.
+struct BracketExit : SentimentExit
+{
+    double stopLoss;        // Close once the price falls this fraction below the buy price
+    double takeProfit;      // Close once the price rises this fraction above the buy price
+
+    double stopPrice(double buyPrice) const
+    {
+        return stopLoss > 0 ? buyPrice * (1.0 - stopLoss) : -numeric_limits<double>::infinity();
+    }
+    double targetPrice(double buyPrice) const
+    {
+        return takeProfit > 0 ? buyPrice * (1.0 + takeProfit) : numeric_limits<double>::infinity();
+    }
+};
+
+// Invests a fixed fraction of the current cash balance
+struct FixedFractionSizing
+{
+    double fraction;        // Fraction of cash allocated on each buy
+
+    double cash(double balance) const { return balance * fraction; }
+};
+
+// A complete strategy: similarity filter plus entry, exit and sizing rules
+template<typename Entry, typename Exit, typename Sizing>
+struct StrategyEngine
+{
+    double similarityThreshold;     // Minimum similarity to consider an event
+    Entry entry;
+    Exit exit;
+    Sizing sizing;
+
+    // Decides what to do with an event. Sell signals win over buy signals, so
+    // overlapping thresholds never buy into a company with bad news.
+    StrategyAction decide(double similarity, double sentiment) const
+    {
+        if (similarity < similarityThreshold) return StrategyAction::Ignore;
+        if (exit.closes(sentiment)) return StrategyAction::Sell;
+        if (entry.opens(sentiment)) return StrategyAction::Buy;
+        return StrategyAction::Hold;
+    }
+
+    // Amount of cash to put into a new position
+    double positionCash(double balance) const { return sizing.cash(balance); }
+
+    // Time at which a position bought at buyTime is force-sold
+    int64_t expiry(int64_t buyTime) const { return exit.expiry(buyTime); }
+};
+
+// The sentiment-threshold strategy used by the live trader and the parameter sweeps
+using ThresholdStrategy = StrategyEngine<SentimentEntry, SentimentExit, FixedFractionSizing>;
+
+// Builds a ThresholdStrategy from its parameters
+inline ThresholdStrategy makeThresholdStrategy(double investPercent, double buyThreshold, double sellThreshold,
+                                               double similarityThreshold, int holdSeconds)
+{
+    return {similarityThreshold, {buyThreshold}, {sellThreshold, holdSeconds}, {investPercent}};
+}
+
+// The threshold strategy with stop-loss and take-profit exits
+using BracketStrategy = StrategyEngine<SentimentEntry, BracketExit, FixedFractionSizing>;
+
+// Builds a BracketStrategy from its parameters
+inline BracketStrategy makeBracketStrategy(double investPercent, double buyThreshold, double sellThreshold,
+                                           double similarityThreshold, int holdSeconds,
+                                           double stopLoss, double takeProfit)
+{
+    return {similarityThreshold, {buyThreshold}, {{sellThreshold, holdSeconds}, stopLoss, takeProfit},
+            {investPercent}};
+}
+
+#endif // STRATEGY_ENGINE_H
@@ -0,0 +1,102 @@
+#ifndef URL_DEDUP_H
+#define URL_DEDUP_H
+
+// Includes most standard C++ libraries
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace chrono;
+
+// === Seen-URL set ===
+
+// Remembers which article URLs have been seen recently, in fixed memory.
+//
+// URLs are stored as 64-bit fingerprints in open-addressing tables split into
+// shards, each with its own mutex, so threads checking different URLs rarely
+// contend. An entry expires ttl after it was first seen and its slot is then
+// reused. A lookup probes at most a short window of slots; if every slot of the
+// window is live, the oldest entry is evicted, so a full set forgets its
+// oldest URLs instead of growing or slowing down.
+//
+// A two-generation Bloom filter, read without locks, answers most checks of
+// new URLs without touching a shard. Generations rotate every ttl, so the
+// filter never misses a live entry and never fills up.
+class UrlDedupSet
+{
+public:
+    // Capacity is rounded up to a power of two, at least one probe window per shard
+    explicit UrlDedupSet(size_t capacity = 131072, seconds ttl = hours(72));
+
+    UrlDedupSet(const UrlDedupSet&) = delete;
+    UrlDedupSet& operator=(const UrlDedupSet&) = delete;
+
+    // Resizes and clears the set (startup only, before other threads use it)
+    void configure(size_t capacity, seconds ttl);
+
+    // Records a URL as seen; true if it was not seen within the last ttl
+    bool insert(string_view url) { return insert(url, now()); }
+    bool insert(string_view url, int64_t nowSeconds);
+
+    // Forgets a URL, so the next insert() of it succeeds; true if it was live
+    bool erase(string_view url);
+
+    // Whether a URL was seen within the last ttl
+    bool contains(string_view url) const { return contains(url, now()); }
+    bool contains(string_view url, int64_t nowSeconds) const;
+
+    // Counters since startup
+    uint64_t duplicates() const { return duplicateCount.load(memory_order_relaxed); }
+    uint64_t evictions() const { return evictionCount.load(memory_order_relaxed); }
+    uint64_t filterSkips() const { return filterSkipCount.load(memory_order_relaxed); }
+
+    size_t capacity() const { return shards.size() * shardSlots; }
+
+    // 64-bit fingerprint of a URL (never 0, which marks an empty slot)
+    static uint64_t fingerprint(string_view url);
+
+    // Seconds on the steady clock
+    static int64_t now();
+
+private:
+    static constexpr size_t SHARD_BITS = 4;         // 16 shards
+    static constexpr size_t PROBE_WINDOW = 16;      // Slots examined per lookup
+    static constexpr int BLOOM_HASHES = 4;          // Bits set per URL
+    static constexpr size_t BLOOM_BITS_PER_SLOT = 8;
+
+    // One shard: parallel arrays of fingerprints and first-seen times
+    struct Shard
+    {
+        mutable mutex lock;
+        vector<uint64_t> keys;          // 0 = never used
+        vector<int64_t> seenAt;         // Seconds on the steady clock
+    };
+
+    // Whether the filter may contain a fingerprint (false means certainly not seen)
+    bool mayContain(uint64_t key) const;
+
+    // Adds a fingerprint to the current filter generation, rotating it if it is older than ttl
+    void addToFilter(uint64_t key, int64_t nowSeconds);
+
+    // Bit positions of a fingerprint in a filter generation
+    size_t filterBit(uint64_t key, int i) const;
+
+    Shard& shardOf(uint64_t key) { return shards[key >> (64 - SHARD_BITS)]; }
+    const Shard& shardOf(uint64_t key) const { return shards[key >> (64 - SHARD_BITS)]; }
+
+    array<Shard, size_t(1) << SHARD_BITS> shards;
+    size_t shardSlots = 0;              // Slots per shard (power of two)
+    int64_t ttlSeconds = 0;
+
+    // Bloom filter generations; `current` takes new URLs, the other keeps the previous ttl's
+    unique_ptr<atomic<uint64_t>[]> filter[2];
+    size_t filterWords = 0;
+    atomic<int> current{0};
+    atomic<int64_t> generationStart{0};
+    mutex rotateLock;
+
+    atomic<uint64_t> duplicateCount{0};
+    atomic<uint64_t> evictionCount{0};
+    atomic<uint64_t> filterSkipCount{0};
+};
+
+#endif // URL_DEDUP_H
@@ -24,6 +24,15 @@ int main()
         cfg = loadSettings(filename); 
         safeCout("[INFO] ", "Settings successfully loaded from: " + filename + "\n\n");
         
+        // Bound the pipeline queues as configured (before any thread, including the debug monitor, reads them)
+        OverflowPolicy overflow = parseOverflowPolicy(cfg.queueOverflowPolicy.empty() ? "block" : cfg.queueOverflowPolicy);
+        newsQueue.configure(cfg.newsQueueCapacity > 0 ? cfg.newsQueueCapacity : 1000, overflow);
+        companyStatusQueue.configure(cfg.statusQueueCapacity > 0 ? cfg.statusQueueCapacity : 1000, overflow);
+
+        // Size the seen-URL set as configured
+        seenUrls.configure(cfg.seenUrlCapacity > 0 ? cfg.seenUrlCapacity : 131072,
+                           hours(cfg.seenUrlTtlHours > 0 ? cfg.seenUrlTtlHours : 72));
+
         // Start the startDebugMonitor function in another thread if debug is enabled in settings
         if(cfg.debug)
         {
@@ -45,6 +54,9 @@ int main()
             safeCout("[INFO] ", "Log file initialized: " + logFileName + "\n\n");
         }
         
+        // Load the company embeddings before any article is processed
+        loadCompanyIndex();
+
         // Start the newsPolling function in a new thread
         threads.push_back(thread(newsPolling)); 
 
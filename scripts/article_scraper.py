@@ -4,11 +4,15 @@ from newspaper import Article
 # Import sys to access command-line arguments and standard error output
 import sys
 
+# Import os and threading for the wall-clock limit on the whole scrape
+import os
+import threading
+
 # Define a function to fetch and print the full article text from a given URL
-def fetch_article(url):
+def fetch_article(url, timeout):
     try:
-        # Create an Article object using the provided URL
-        article = Article(url)
+        # Create an Article object using the provided URL; downloads give up after `timeout` seconds
+        article = Article(url, request_timeout=timeout)
 
         # Download the article's HTML content
         article.download()
@@ -31,8 +35,21 @@ if __name__ == "__main__":
     # Check if the user passed a URL argument to the script
     if len(sys.argv) < 2:
         # If not, print usage instructions and exit with error code 1
-        print("Usage: python article_scraper.py <url>", file=sys.stderr)
+        print("Usage: python article_scraper.py <url> [timeout_seconds]", file=sys.stderr)
         sys.exit(-2)
 
-    # Pass the provided URL to the scraping function
-    fetch_article(sys.argv[1])
+    timeout = int(sys.argv[2]) if len(sys.argv) > 2 else 20
+
+    # request_timeout only limits each HTTP call; a site that keeps redirecting or trickles its
+    # response could still hold the scrape forever, so the whole scrape gets the same limit
+    def give_up():
+        print(f"[ERROR] Scrape took longer than {timeout} seconds", file=sys.stderr)
+        sys.stderr.flush()
+        os._exit(-3)
+
+    watchdog = threading.Timer(timeout, give_up)
+    watchdog.daemon = True
+    watchdog.start()
+
+    # Pass the provided URL and download timeout to the scraping function
+    fetch_article(sys.argv[1], timeout)
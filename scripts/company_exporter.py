@@ -0,0 +1,64 @@
+# Downloads every company of the AstraDB collection, with its embedding, into
+# the local file the C++ CompanyIndex loads at startup.
+#
+# File layout (little endian):
+#   char[8] "NDTEMBED", uint32 version (1), uint32 count, uint32 dimension, uint32 reserved
+#   count x (uint32 name length, name, uint32 ticker length, ticker)   -- UTF-8
+#   count x dimension float32 embedding values, one row per company
+
+# Import required libraries
+import os
+import struct
+import sys
+from astrapy import DataAPIClient
+
+
+# Packs one length-prefixed UTF-8 string
+def pack_string(s):
+    data = s.encode("utf-8")
+    return struct.pack("<I", len(data)) + data
+
+
+def export_companies(collection, path):
+    companies = []
+    dimension = None
+    for doc in collection.find(filter={}, projection={"name": True, "ticker": True, "$vector": True}):
+        vector = doc["$vector"]
+        if dimension is None:
+            dimension = len(vector)
+        elif len(vector) != dimension:
+            raise ValueError(f"{doc['ticker']}: embedding has {len(vector)} values, expected {dimension}")
+        companies.append((doc["name"], doc["ticker"], vector))
+
+    if not companies:
+        raise ValueError("The companies collection is empty")
+
+    # Written next to the target and renamed, so a failed export never leaves half a file
+    tmp = path + ".tmp"
+    with open(tmp, "wb") as f:
+        f.write(b"NDTEMBED" + struct.pack("<IIII", 1, len(companies), dimension, 0))
+        for name, ticker, _ in companies:
+            f.write(pack_string(name) + pack_string(ticker))
+        for _, _, vector in companies:
+            f.write(struct.pack(f"<{dimension}f", *vector))
+    os.replace(tmp, path)
+    print(f"Exported {len(companies)} companies ({dimension} dimensions) to {path}")
+
+
+# Run if executed directly
+if __name__ == "__main__":
+    # Expect: script.py <ASTRA_TOKEN> <ASTRA_ENDPOINT> <output_file>
+    if len(sys.argv) < 4:
+        print("Usage: python company_exporter.py <ASTRA_TOKEN> <ASTRA_ENDPOINT> <output_file>", file=sys.stderr)
+        sys.exit(-2)
+
+    try:
+        # Initialize AstraDB client and collection
+        client = DataAPIClient(sys.argv[1])
+        db = client.get_database_by_api_endpoint(sys.argv[2])
+        collection = db.get_collection("companiesdb")
+        export_companies(collection, sys.argv[3])
+    except Exception as e:
+        # On error, print to stderr and exit with failure code
+        print(f"[ERROR] {e}", file=sys.stderr)
+        sys.exit(-1)
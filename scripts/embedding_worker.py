@@ -0,0 +1,41 @@
+# Long-lived embedding worker: keeps one OpenAI client, then answers framed
+# requests on stdin/stdout until stdin is closed (see frame_worker.py).
+#
+#   request payload:  article text (UTF-8)
+#   response payload: b"VEC " followed by the embedding as little-endian
+#                     float32 values, or "ERROR <message>"
+
+# Import required libraries
+import struct
+import sys
+import openai
+
+# Shared request loop
+from frame_worker import serve
+
+# Must match the model the company vectors were embedded with
+MODEL = "text-embedding-3-large"
+
+
+def run(max_batch: int):
+    # Embeds every waiting article in one API call
+    def handle_batch(payloads):
+        texts = [p.decode("utf-8", errors="replace") for p in payloads]
+        response = openai.Embedding.create(input=texts, model=MODEL)
+        vectors = sorted(response["data"], key=lambda d: d["index"])
+        return [b"VEC " + struct.pack(f"<{len(v['embedding'])}f", *v["embedding"]) for v in vectors]
+
+    serve(handle_batch, max_batch)
+
+
+# Run if executed directly
+if __name__ == "__main__":
+    # Expect: script.py <OPENAI_KEY> [max_batch]
+    if len(sys.argv) < 2:
+        print("Usage: python embedding_worker.py <OPENAI_KEY> [max_batch]", file=sys.stderr)
+        sys.exit(-2)
+
+    # Configure API key
+    openai.api_key = sys.argv[1]
+    max_batch = int(sys.argv[2]) if len(sys.argv) > 2 else 16
+    run(max_batch)
@@ -0,0 +1,84 @@
+# Request loop shared by the long-lived worker scripts (sentiment_worker.py,
+# embedding_worker.py), which the C++ side drives through PythonWorker.
+#
+# Frame (both directions): uint32 id, uint32 payload length (little endian),
+# then the payload. A response payload starting with b"ERROR " reports a failure.
+#
+# Requests that arrive while a batch is being handled are handled together
+# in the next one (up to max_batch at a time).
+
+# Standard library helpers for framing, threading and error output
+import queue
+import struct
+import sys
+import threading
+
+HEADER = struct.Struct("<II")
+
+
+# Reads exactly n bytes from a binary stream; returns None at end of stream
+def read_exact(stream, n):
+    data = b""
+    while len(data) < n:
+        chunk = stream.read(n - len(data))
+        if not chunk:
+            return None
+        data += chunk
+    return data
+
+
+# Moves incoming requests onto the queue; None marks the end of input
+def read_requests(stream, requests):
+    while True:
+        header = read_exact(stream, HEADER.size)
+        if header is None:
+            break
+        request_id, length = HEADER.unpack(header)
+        payload = read_exact(stream, length)
+        if payload is None:
+            break
+        requests.put((request_id, payload))
+    requests.put(None)
+
+
+# Writes one response frame
+def write_response(stream, request_id, payload):
+    stream.write(HEADER.pack(request_id, len(payload)))
+    stream.write(payload)
+
+
+# Answers requests until stdin is closed. handle_batch maps a list of request
+# payloads (bytes) to a list of response payloads (bytes) in the same order.
+def serve(handle_batch, max_batch):
+    requests = queue.Queue()
+    reader = threading.Thread(target=read_requests, args=(sys.stdin.buffer, requests), daemon=True)
+    reader.start()
+    out = sys.stdout.buffer
+
+    finished = False
+    while not finished:
+        # Block for one request, then take whatever else is already waiting
+        first = requests.get()
+        if first is None:
+            break
+        batch = [first]
+        while len(batch) < max(1, max_batch):
+            try:
+                item = requests.get_nowait()
+            except queue.Empty:
+                break
+            if item is None:
+                finished = True
+                break
+            batch.append(item)
+
+        try:
+            responses = handle_batch([payload for _, payload in batch])
+            for (request_id, _), response in zip(batch, responses):
+                write_response(out, request_id, response)
+        except Exception as e:
+            # Report the failure for every request of the batch and keep serving
+            print(f"[ERROR] {e}", file=sys.stderr)
+            for request_id, _ in batch:
+                write_response(out, request_id, f"ERROR {e}".encode("utf-8"))
+        out.flush()
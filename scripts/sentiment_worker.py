@@ -0,0 +1,46 @@
+# Long-lived sentiment worker: loads the model once, then answers framed
+# requests on stdin/stdout until stdin is closed (see frame_worker.py).
+#
+#   request payload:  article text (UTF-8)
+#   response payload: "<LABEL> <score>" (e.g. "POSITIVE 0.998") or "ERROR <message>"
+
+# Import the pipeline class from the transformers library
+from transformers import pipeline
+
+# Import sys for arguments and error output, and the shared request loop
+import sys
+from frame_worker import serve
+
+
+def run(use_gpu: bool, max_batch: int):
+    # Load the pre-trained sentiment analysis model (DistilBERT fine-tuned for SST-2) once
+    sentiment_analysis = pipeline(
+        "sentiment-analysis",
+        model="distilbert-base-uncased-finetuned-sst-2-english",
+        device=0 if use_gpu else -1
+    )
+
+    # Classifies every waiting article in one forward pass
+    def handle_batch(payloads):
+        texts = [p.decode("utf-8", errors="replace") for p in payloads]
+        # Long articles are cut to the model's input size
+        results = sentiment_analysis(texts, batch_size=len(texts), truncation=True)
+        return [f"{r['label']} {r['score']}".encode("utf-8") for r in results]
+
+    serve(handle_batch, max_batch)
+
+
+# Run this block only if the script is being executed directly (not imported)
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        print("Usage: python sentiment_worker.py <use_gpu> [max_batch]", file=sys.stderr)
+        sys.exit(-2)
+
+    use_gpu = sys.argv[1].lower() in ("true", "1")
+    max_batch = int(sys.argv[2]) if len(sys.argv) > 2 else 16
+    try:
+        run(use_gpu, max_batch)
+    except Exception as e:
+        # Loading the model failed; the C++ side sees the pipe close
+        print(f"[ERROR] {e}", file=sys.stderr)
+        sys.exit(-1)
@@ -0,0 +1,76 @@
+// Includes standard C++ libraries and project-specific headers
+#include "backtest.h"
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// === PriceLookupIndex ===
+
+// Global record number of a ticker's first price at or after time t
+uint64_t findPriceRecord(TickerId tickerId, int64_t t)
+{
+    PriceSeries prices = priceData.series(tickerId);
+    size_t it = prices.lowerBound(t);
+    if (it == prices.size) return PriceLookupIndex::NO_PRICE;
+    return priceData.recordOffset(tickerId) + it;
+}
+
+// Resolves entry and exit records for every event in newsData from firstEvent on
+void PriceLookupIndex::build(const vector<int>& durations, size_t firstEvent)
+{
+    holdDurations = durations;
+    sort(holdDurations.begin(), holdDurations.end());
+    holdDurations.erase(unique(holdDurations.begin(), holdDurations.end()), holdDurations.end());
+
+    entry.assign(newsData.size(), NO_PRICE);
+    exits.assign(holdDurations.size(), vector<uint64_t>(newsData.size(), NO_PRICE));
+    for (size_t i = firstEvent; i < newsData.size(); ++i)
+    {
+        const NewsEntry& news = newsData[i];
+        entry[i] = findPriceRecord(news.tickerId, news.timestamp);
+        for (size_t h = 0; h < holdDurations.size(); ++h)
+        {
+            exits[h][i] = findPriceRecord(news.tickerId, news.timestamp + holdDurations[h]);
+        }
+    }
+}
+
+// Exit records for a hold duration, or nullptr if it was not indexed
+const uint64_t* PriceLookupIndex::exitsFor(int holdDurationSecs) const
+{
+    auto it = lower_bound(holdDurations.begin(), holdDurations.end(), holdDurationSecs);
+    if (it == holdDurations.end() || *it != holdDurationSecs) return nullptr;
+    return exits[it - holdDurations.begin()].data();
+}
+
+// === Simulation functions ===
+
+// Runs a single simulation with the given strategy parameters over loaded data.
+// investPercent: fraction of cash to allocate on each buy
+// buyThreshold: minimum sentiment score to trigger a buy
+// sellThreshold: maximum sentiment score to trigger a sell
+// similarityThreshold: minimum similarity to consider an event
+// holdDurationSecs: time (in seconds) to hold before forced sell
+// lookup: shared entry/exit price records for every news event
+// state: portfolio owned by the caller, reset before the run
+// totalTrades: output parameter for count of buy actions
+// profitableTrades: output for count of profitable sells
+// tradeStats: running statistics of every closed trade's P&L
+// events: range of newsData to run over (defaults to all of it)
+// Returns final cash balance after running through all events
+double simulate(double investPercent,
+                double buyThreshold,
+                double sellThreshold,
+                double similarityThreshold,
+                int holdDurationSecs,
+                const PriceLookupIndex &lookup,
+                SimulationState &state,
+                int &totalTrades,
+                int &profitableTrades,
+                TradeStats &tradeStats,
+                EventRange events)
+{
+    ThresholdStrategy strategy = makeThresholdStrategy(investPercent, buyThreshold, sellThreshold,
+                                                       similarityThreshold, holdDurationSecs);
+    return simulateStrategy(strategy, lookup, state, totalTrades, profitableTrades, tradeStats, events);
+}
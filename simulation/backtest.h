@@ -0,0 +1,296 @@
+#ifndef BACKTEST_H
+#define BACKTEST_H
+
+// Includes standard C++ libraries and project-specific headers
+#include <bits/stdc++.h>
+#include "market_data.h"
+#include "trade_stats.h"
+#include "../include/strategy_engine.h"
+
+using namespace std;
+
+// === Data structures used during simulation ===
+
+// Represents a held position: quantity bought, purchase price and time
+struct InvestmentNode
+{
+    uint64_t seq;                       // Run-unique position number, in buy order
+    double quantity;                    // Number of shares bought
+    double buyPrice;                    // Price per share at purchase
+    int64_t buyTime;                    // Time the position was opened (seconds since epoch)
+    uint64_t exitRecord;                // Price record used for the forced sell
+};
+
+// Scheduled forced sell of one position, ordered by expiry time
+struct ExpiryEntry
+{
+    int64_t expiry;                     // buyTime + hold duration
+    uint64_t seq;                       // Position the entry belongs to
+    TickerId tickerId;                  // Ticker holding the position
+
+    // Min-heap ordering: earliest expiry first, buy order breaks ties
+    bool operator>(const ExpiryEntry& other) const
+    {
+        return expiry != other.expiry ? expiry > other.expiry : seq > other.seq;
+    }
+};
+
+// Open positions of one ticker in buy order. Closing a position only advances
+// `head`; the storage is kept when the queue drains, so once a worker's queues
+// have grown to their working size a run allocates nothing.
+struct PositionQueue
+{
+    vector<InvestmentNode> nodes;       // Positions; [head, size) are open
+    size_t head = 0;                    // First open position
+
+    bool empty() const { return head == nodes.size(); }
+    InvestmentNode& front() { return nodes[head]; }
+    void push_back(const InvestmentNode& node) { nodes.push_back(node); }
+
+    // Closes the oldest position, compacting once most of the storage is dead
+    void pop_front()
+    {
+        if (++head == nodes.size())
+        {
+            clear();
+        }
+        else if (head >= 64 && head * 2 >= nodes.size())
+        {
+            nodes.erase(nodes.begin(), nodes.begin() + head);
+            head = 0;
+        }
+    }
+
+    void clear()
+    {
+        nodes.clear();
+        head = 0;
+    }
+};
+
+// Per-run portfolio state: open positions for every ticker held by one simulation.
+// Each sweep worker owns its own instance so runs never share positions.
+struct SimulationState
+{
+    // Open positions indexed by ticker ID
+    vector<PositionQueue> investmentMap;
+
+    // Min-heap of forced-sell times for every position opened in this run.
+    // Entries of positions closed early by a sell signal are left in place and
+    // discarded when they reach the top.
+    vector<ExpiryEntry> expiries;
+
+    // Sequence number for the next opened position
+    uint64_t nextSeq = 0;
+
+    // Drops all open positions before the next run (one slot per known ticker)
+    void reset()
+    {
+        investmentMap.resize(priceData.tickerCount());
+        for (auto& positions : investmentMap) positions.clear();
+        expiries.clear();
+        nextSeq = 0;
+    }
+};
+
+// Half-open range of newsData indices a simulation runs over
+struct EventRange
+{
+    size_t begin = 0;                               // First event processed
+    size_t end = numeric_limits<size_t>::max();     // One past the last event (clamped)
+};
+
+// Price lookups resolved once per dataset and shared read-only by every run.
+// All indices are global record numbers into priceData (see PriceStore::recordPrice).
+struct PriceLookupIndex
+{
+    // Marks a lookup with no price at or after the requested time
+    static constexpr uint64_t NO_PRICE = numeric_limits<uint64_t>::max();
+
+    // Per news event: first price record of its ticker at or after the news time
+    vector<uint64_t> entry;
+
+    // Hold durations (in seconds) covered by `exits`
+    vector<int> holdDurations;
+
+    // Per hold duration, per news event: first price record at or after
+    // news time + hold duration (the forced-sell price of a buy at that event)
+    vector<vector<uint64_t>> exits;
+
+    // Resolves entry and exit records for every event in newsData from
+    // firstEvent on; earlier events are left at NO_PRICE
+    void build(const vector<int>& durations, size_t firstEvent = 0);
+
+    // Exit records for a hold duration, or nullptr if it was not indexed
+    const uint64_t* exitsFor(int holdDurationSecs) const;
+};
+
+// Global record number of a ticker's first price at or after time t
+// (PriceLookupIndex::NO_PRICE if there is none)
+uint64_t findPriceRecord(TickerId tickerId, int64_t t);
+
+// === Simulation functions ===
+
+// Event source of simulateStrategy(): newsData[begin, end) with prices
+// resolved by the lookup index for one hold duration. Any type with the same
+// members can drive runStrategy().
+struct LookupEvents
+{
+    const PriceLookupIndex& lookup;
+    const uint64_t* exits;              // lookup.exitsFor(hold)
+    size_t begin;
+    size_t end;
+
+    size_t size() const { return end - begin; }
+    const NewsEntry& news(size_t j) const { return newsData[begin + j]; }
+    int64_t time(size_t j) const { return newsData[begin + j].timestamp; }
+    uint64_t entryRecord(size_t j) const { return lookup.entry[begin + j]; }
+    uint64_t exitRecord(size_t j) const { return exits[begin + j]; }
+};
+
+// Continues one strategy (a StrategyEngine instantiation) from `balance`, the
+// open positions in `state` and the given counters over a chronological stream
+// of later events. Each strategy and event-source type gets its own compiled
+// copy of the loop; with a warmed-up state nothing is allocated.
+template<typename Strategy, typename Events>
+double resumeStrategy(const Strategy& strategy,
+                      const Events& events,
+                      SimulationState &state,
+                      double balance,
+                      int &totalTrades,
+                      int &profitableTrades,
+                      TradeStats &tradeStats)
+{
+    auto& investmentMap = state.investmentMap;
+    auto& expiries = state.expiries;
+
+    // Iterate through each event chronologically
+    size_t eventCount = events.size();
+    for (size_t j = 0; j < eventCount; ++j)
+    {
+        auto const& news = events.news(j);
+        int64_t now = events.time(j);
+
+        // Skip events with low similarity
+        StrategyAction action = strategy.decide(news.similarity, news.sentiment);
+        if (action == StrategyAction::Ignore) continue;
+
+        // Price at or just after the news timestamp, resolved ahead of time
+        uint64_t entryRecord = events.entryRecord(j);
+        if (entryRecord == PriceLookupIndex::NO_PRICE) continue;
+        double currentPrice = priceData.recordPrice(entryRecord);
+
+        // --- SELL: negative sentiment triggers closing all positions for ticker ---
+        if (action == StrategyAction::Sell)
+        {
+            auto& invList = investmentMap[news.tickerId];
+            while (!invList.empty())
+            {
+                auto node = invList.front();
+                double pnl = node.quantity * (currentPrice - node.buyPrice);
+                if (pnl > 0) ++profitableTrades;
+                tradeStats.add(pnl);
+                balance += node.quantity * currentPrice;
+                invList.pop_front();
+            }
+        }
+        // --- BUY: positive sentiment triggers opening a new position ---
+        else if (action == StrategyAction::Buy)
+        {
+            double toInvest = strategy.positionCash(balance);
+            double qty = toInvest / currentPrice;
+            balance -= toInvest;
+            ++totalTrades;
+            uint64_t seq = state.nextSeq++;
+            investmentMap[news.tickerId].push_back({
+                seq, qty, currentPrice, now, events.exitRecord(j)
+            });
+            expiries.push_back({strategy.expiry(now), seq, news.tickerId});
+            push_heap(expiries.begin(), expiries.end(), greater<ExpiryEntry>());
+        }
+
+        // --- Force SELL: positions exceeding hold duration are closed ---
+        // Only positions whose expiry has passed are visited, earliest first
+        while (!expiries.empty() && expiries.front().expiry <= now)
+        {
+            ExpiryEntry due = expiries.front();
+            pop_heap(expiries.begin(), expiries.end(), greater<ExpiryEntry>());
+            expiries.pop_back();
+
+            // Positions of a ticker expire in buy order, so a live entry always
+            // matches the front of its queue. Anything else was either closed by a
+            // sell signal or queued behind a position that could not be priced.
+            auto& invList = investmentMap[due.tickerId];
+            if (invList.empty() || invList.front().seq != due.seq) continue;
+
+            // Price at forced sell time in the position's own price series was
+            // resolved at buy time; without a later price the position stays open
+            auto node = invList.front();
+            if (node.exitRecord == PriceLookupIndex::NO_PRICE) continue;
+            double sellPrice = priceData.recordPrice(node.exitRecord);
+
+            double pnl = node.quantity * (sellPrice - node.buyPrice);
+            if (pnl > 0) ++profitableTrades;
+            tradeStats.add(pnl);
+            balance += node.quantity * sellPrice;
+            invList.pop_front();
+        }
+    }
+
+    return balance;
+}
+
+// Runs one strategy over a chronological stream of events, starting with
+// $10000 and no positions
+template<typename Strategy, typename Events>
+double runStrategy(const Strategy& strategy,
+                   const Events& events,
+                   SimulationState &state,
+                   int &totalTrades,
+                   int &profitableTrades,
+                   TradeStats &tradeStats)
+{
+    state.reset();
+    totalTrades = profitableTrades = 0;
+    tradeStats.reset();
+    return resumeStrategy(strategy, events, state, 10000.0, totalTrades, profitableTrades, tradeStats);
+}
+
+// Runs one strategy over loaded data, or only over the events in `events`.
+// The exit policy's holdSeconds must be covered by the lookup index.
+template<typename Strategy>
+double simulateStrategy(const Strategy& strategy,
+                        const PriceLookupIndex &lookup,
+                        SimulationState &state,
+                        int &totalTrades,
+                        int &profitableTrades,
+                        TradeStats &tradeStats,
+                        EventRange events = {})
+{
+    const uint64_t* exitRecords = lookup.exitsFor(strategy.exit.holdSeconds);
+    if (!exitRecords)
+    {
+        throw invalid_argument("Hold duration " + to_string(strategy.exit.holdSeconds) + "s is not in the price lookup index");
+    }
+
+    size_t end = min(events.end, newsData.size());
+    LookupEvents source{lookup, exitRecords, min(events.begin, end), end};
+    return runStrategy(strategy, source, state, totalTrades, profitableTrades, tradeStats);
+}
+
+// Runs a single simulation of the threshold strategy with the given parameters
+// over loaded data (or only over the events in `events`). The hold duration must
+// be covered by the lookup index.
+double simulate(double investPercent,
+                double buyThreshold,
+                double sellThreshold,
+                double similarityThreshold,
+                int holdDurationSecs,
+                const PriceLookupIndex &lookup,
+                SimulationState &state,
+                int &totalTrades,
+                int &profitableTrades,
+                TradeStats &tradeStats,
+                EventRange events = {});
+
+#endif // BACKTEST_H
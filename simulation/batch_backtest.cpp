@@ -0,0 +1,257 @@
+// Includes standard C++ libraries and project-specific headers
+#include "batch_backtest.h"
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// Lanes are padded to this multiple so every lane loop runs on full vectors
+// (8 doubles = one AVX-512 register, two AVX2 registers)
+static constexpr size_t LANE_ALIGN = 8;
+
+// === BatchState ===
+
+// Clears everything and sizes the lane arrays for a new batch
+void BatchState::reset(size_t laneCount)
+{
+    lanes = laneCount;
+    stride = (laneCount + LANE_ALIGN - 1) / LANE_ALIGN * LANE_ALIGN;
+
+    // Padding lanes get thresholds no event can reach, so they never act
+    invest.assign(stride, 0.0);
+    buyT.assign(stride, numeric_limits<double>::infinity());
+    sellT.assign(stride, -numeric_limits<double>::infinity());
+    simT.assign(stride, numeric_limits<double>::infinity());
+    balance.assign(stride, 10000.0);    // Starting cash balance
+    trades.assign(stride, 0);
+    profitable.assign(stride, 0);
+    cursor.assign(stride, 0);
+    active.assign(stride, 0);
+    selling.assign(stride, 0);
+    buying.assign(stride, 0);
+
+    lotBase = 0;
+    lotHead = 0;
+    lotTicker.clear();
+    lotBuyPrice.clear();
+    lotExpiry.clear();
+    lotExit.clear();
+    lotQty.clear();
+
+    tickerLots.resize(priceData.tickerCount());
+    for (auto& lots : tickerLots) lots.clear();
+}
+
+// === Kernel helpers ===
+
+// Closes, at `price`, the positions of every lane selected by `mask` that still
+// hold the lot `lotId` (lanes whose cursor passed the lot no longer own it)
+static void closeLot(BatchState& st, uint64_t lotId, double price, const int64_t* mask,
+                     vector<StrategyOutcome>& outcomes)
+{
+    double* __restrict row = &st.lotQty[(lotId - st.lotBase) * st.stride];
+    const uint64_t* __restrict cursor = st.cursor.data();
+    double* __restrict balance = st.balance.data();
+    int64_t* __restrict profitable = st.profitable.data();
+    double buyPrice = st.lotBuyPrice[lotId - st.lotBase];
+
+    // Record the P&L of each closed position (scalar: statistics are per lane)
+    for (size_t k = 0; k < st.lanes; ++k)
+    {
+        if (mask[k] && lotId >= cursor[k] && row[k] > 0)
+        {
+            outcomes[k].tradeStats.add(row[k] * (price - buyPrice));
+        }
+    }
+
+    // Credit the sale and clear the positions (branch-free over all lanes)
+    for (size_t k = 0; k < st.stride; ++k)
+    {
+        bool sell = mask[k] && lotId >= cursor[k] && row[k] > 0;
+        double pnl = row[k] * (price - buyPrice);
+        balance[k] += sell ? row[k] * price : 0.0;
+        profitable[k] += (sell && pnl > 0) ? 1 : 0;
+        row[k] = sell ? 0.0 : row[k];
+    }
+}
+
+// True once no lane can ever sell the lot again: every lane either holds none
+// of it or has already moved its forced-sell cursor past it (a lot passed by a
+// cursor while still held had no exit price, so it can never be sold)
+static bool lotClosed(const BatchState& st, uint64_t lotId)
+{
+    const double* row = &st.lotQty[(lotId - st.lotBase) * st.stride];
+    int64_t open = 0;
+    for (size_t k = 0; k < st.stride; ++k)
+    {
+        open |= (row[k] > 0 && lotId >= st.cursor[k]) ? 1 : 0;
+    }
+    return open == 0;
+}
+
+// Drops closed lots from the front of the lot arrays and compacts them
+// once the dead prefix is large enough to be worth moving
+static void releaseClosedLots(BatchState& st)
+{
+    size_t stored = st.lotTicker.size();
+    while (st.lotHead < stored && lotClosed(st, st.lotBase + st.lotHead))
+    {
+        ++st.lotHead;
+    }
+
+    if (st.lotHead >= 1024 && st.lotHead * 2 >= stored)
+    {
+        size_t drop = st.lotHead;
+        st.lotTicker.erase(st.lotTicker.begin(), st.lotTicker.begin() + drop);
+        st.lotBuyPrice.erase(st.lotBuyPrice.begin(), st.lotBuyPrice.begin() + drop);
+        st.lotExpiry.erase(st.lotExpiry.begin(), st.lotExpiry.begin() + drop);
+        st.lotExit.erase(st.lotExit.begin(), st.lotExit.begin() + drop);
+        st.lotQty.erase(st.lotQty.begin(), st.lotQty.begin() + drop * st.stride);
+        st.lotBase += drop;
+        st.lotHead = 0;
+    }
+}
+
+// === Kernel ===
+
+// Runs every strategy in `params` over newsData (or a range of it) in a single pass
+void simulateBatch(const vector<StrategyParams>& params,
+                   int holdDurationSecs,
+                   const PriceLookupIndex& lookup,
+                   BatchState& st,
+                   vector<StrategyOutcome>& outcomes,
+                   EventRange events)
+{
+    const uint64_t* exitRecords = lookup.exitsFor(holdDurationSecs);
+    if (!exitRecords)
+    {
+        throw invalid_argument("Hold duration " + to_string(holdDurationSecs) + "s is not in the price lookup index");
+    }
+
+    st.reset(params.size());
+    for (size_t k = 0; k < params.size(); ++k)
+    {
+        st.invest[k] = params[k].investPercent;
+        st.buyT[k] = params[k].buyThreshold;
+        st.sellT[k] = params[k].sellThreshold;
+        st.simT[k] = params[k].similarityThreshold;
+    }
+    outcomes.resize(params.size());
+    for (auto& o : outcomes)
+    {
+        o.tradeStats.reset();
+    }
+
+    const size_t stride = st.stride;
+    const double* __restrict invest = st.invest.data();
+    const double* __restrict buyT = st.buyT.data();
+    const double* __restrict sellT = st.sellT.data();
+    const double* __restrict simT = st.simT.data();
+    double* __restrict balance = st.balance.data();
+    int64_t* __restrict trades = st.trades.data();
+    int64_t* __restrict active = st.active.data();
+    int64_t* __restrict selling = st.selling.data();
+    int64_t* __restrict buying = st.buying.data();
+
+    // The strategy of lane k, rebuilt from the lane arrays so the compiler keeps
+    // the rules inlined in the lane loops
+    auto laneStrategy = [&](size_t k)
+    {
+        return makeThresholdStrategy(invest[k], buyT[k], sellT[k], simT[k], holdDurationSecs);
+    };
+
+    // Iterate through each news event in the range chronologically
+    size_t lastEvent = min(events.end, newsData.size());
+    for (size_t i = events.begin; i < lastEvent; ++i)
+    {
+        auto const& news = newsData[i];
+
+        // Events without a price are skipped by every lane
+        uint64_t entryRecord = lookup.entry[i];
+        if (entryRecord == PriceLookupIndex::NO_PRICE) continue;
+        double currentPrice = priceData.recordPrice(entryRecord);
+
+        // Lane masks from each lane's strategy: similarity filter, then sell or buy signal
+        int64_t anyActive = 0, anySell = 0, anyBuy = 0;
+        for (size_t k = 0; k < stride; ++k)
+        {
+            StrategyAction action = laneStrategy(k).decide(news.similarity, news.sentiment);
+            int64_t a = action != StrategyAction::Ignore ? 1 : 0;
+            int64_t s = action == StrategyAction::Sell ? 1 : 0;
+            int64_t b = action == StrategyAction::Buy ? 1 : 0;
+            active[k] = a;
+            selling[k] = s;
+            buying[k] = b;
+            anyActive |= a;
+            anySell |= s;
+            anyBuy |= b;
+        }
+        if (!anyActive) continue;
+
+        // --- SELL: negative sentiment closes the lanes' positions in this ticker ---
+        if (anySell)
+        {
+            auto& lots = st.tickerLots[news.tickerId];
+            size_t kept = 0;
+            for (uint64_t lotId : lots)
+            {
+                if (lotId < st.lotBase + st.lotHead) continue;   // Already released
+                closeLot(st, lotId, currentPrice, selling, outcomes);
+                if (!lotClosed(st, lotId)) lots[kept++] = lotId;
+            }
+            lots.resize(kept);
+        }
+
+        // --- BUY: positive sentiment opens one shared lot for all buying lanes ---
+        if (anyBuy)
+        {
+            uint64_t lotId = st.lotBase + st.lotTicker.size();
+            st.lotTicker.push_back(news.tickerId);
+            st.lotBuyPrice.push_back(currentPrice);
+            st.lotExpiry.push_back(laneStrategy(0).expiry(news.timestamp));
+            st.lotExit.push_back(exitRecords[i]);
+            st.lotQty.resize(st.lotQty.size() + stride);
+
+            double* __restrict row = &st.lotQty[(lotId - st.lotBase) * stride];
+            for (size_t k = 0; k < stride; ++k)
+            {
+                double toInvest = buying[k] ? laneStrategy(k).positionCash(balance[k]) : 0.0;
+                row[k] = toInvest / currentPrice;
+                balance[k] -= toInvest;
+                trades[k] += buying[k];
+            }
+            st.tickerLots[news.tickerId].push_back(lotId);
+        }
+
+        // --- Force SELL: active lanes close every lot past its hold duration ---
+        // Scan from the least advanced active cursor; closeLot() skips lanes
+        // that already handled a lot
+        uint64_t from = numeric_limits<uint64_t>::max();
+        for (size_t k = 0; k < stride; ++k)
+        {
+            from = min(from, active[k] ? st.cursor[k] : numeric_limits<uint64_t>::max());
+        }
+        uint64_t lotEnd = st.lotBase + st.lotTicker.size();
+        uint64_t lotId = max(from, st.lotBase + st.lotHead);
+        for (; lotId < lotEnd && st.lotExpiry[lotId - st.lotBase] <= news.timestamp; ++lotId)
+        {
+            // Without a price after expiry the lot stays open in every lane
+            uint64_t exitRecord = st.lotExit[lotId - st.lotBase];
+            if (exitRecord == PriceLookupIndex::NO_PRICE) continue;
+            closeLot(st, lotId, priceData.recordPrice(exitRecord), active, outcomes);
+        }
+        uint64_t* __restrict cursor = st.cursor.data();
+        for (size_t k = 0; k < stride; ++k)
+        {
+            cursor[k] = (active[k] && cursor[k] < lotId) ? lotId : cursor[k];
+        }
+
+        releaseClosedLots(st);
+    }
+
+    for (size_t k = 0; k < st.lanes; ++k)
+    {
+        outcomes[k].balance = balance[k];
+        outcomes[k].totalTrades = static_cast<int>(trades[k]);
+        outcomes[k].profitableTrades = static_cast<int>(st.profitable[k]);
+    }
+}
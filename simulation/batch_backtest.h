@@ -0,0 +1,81 @@
+#ifndef BATCH_BACKTEST_H
+#define BATCH_BACKTEST_H
+
+// Includes standard C++ libraries and project-specific headers
+#include <bits/stdc++.h>
+#include "market_data.h"
+#include "backtest.h"
+
+using namespace std;
+
+// === Batched multi-strategy simulation ===
+//
+// simulateBatch() walks newsData once and advances a whole block of strategies
+// in lockstep. Strategy parameters and balances live in struct-of-arrays form
+// ("lanes"), so threshold checks and balance updates are branch-free loops over
+// contiguous doubles that the compiler vectorizes (build with -O3 -march=native
+// to get AVX2/AVX-512 code).
+//
+// Positions are shared between lanes as "lots": one lot per news event at which
+// at least one lane bought, holding a quantity per lane (zero for lanes that did
+// not buy). All lots share the hold duration, so they expire in creation order
+// and each lane only needs a cursor to the first lot it has not force-sold yet.
+// Results are identical to running simulate() once per strategy.
+
+// Parameters of one strategy evaluated by the batched kernel
+struct StrategyParams
+{
+    double investPercent;           // Fraction of cash to allocate on each buy
+    double buyThreshold;            // Minimum sentiment score to trigger a buy
+    double sellThreshold;           // Maximum sentiment score to trigger a sell
+    double similarityThreshold;     // Minimum similarity to consider an event
+};
+
+// Outcome of one strategy in a batch (same fields simulate() reports)
+struct StrategyOutcome
+{
+    double balance = 0.0;           // Final cash balance
+    int totalTrades = 0;            // Number of buys
+    int profitableTrades = 0;       // Number of profitable sells
+    TradeStats tradeStats;          // Running statistics of every sell's P&L
+};
+
+// Working memory of the kernel, reused across batches by one worker
+struct BatchState
+{
+    size_t lanes = 0;               // Strategies in the current batch
+    size_t stride = 0;              // Lanes rounded up to a full vector width
+
+    // Per-lane strategy parameters and portfolio (padding lanes never act)
+    vector<double> invest, buyT, sellT, simT;
+    vector<double> balance;
+    vector<int64_t> trades, profitable;
+    vector<uint64_t> cursor;        // First lot not yet force-sold by the lane
+    vector<int64_t> active, selling, buying;   // Per-event lane masks (0/1)
+
+    // Lots, indexed by global lot ID - lotBase
+    uint64_t lotBase = 0;           // Global ID of the first stored lot
+    size_t lotHead = 0;             // First stored lot still open in some lane
+    vector<TickerId> lotTicker;     // Ticker of each lot
+    vector<double> lotBuyPrice;     // Entry price shared by all lanes
+    vector<int64_t> lotExpiry;      // Forced-sell time
+    vector<uint64_t> lotExit;       // Forced-sell price record
+    vector<double> lotQty;          // Quantity per lane, `stride` values per lot
+
+    // Global IDs of possibly open lots per ticker, in creation order
+    vector<vector<uint64_t>> tickerLots;
+
+    // Clears everything and sizes the lane arrays for a new batch
+    void reset(size_t laneCount);
+};
+
+// Runs every strategy in `params` over newsData (or the events in `events`) in a
+// single pass. The hold duration must be covered by the lookup index.
+void simulateBatch(const vector<StrategyParams>& params,
+                   int holdDurationSecs,
+                   const PriceLookupIndex& lookup,
+                   BatchState& state,
+                   vector<StrategyOutcome>& outcomes,
+                   EventRange events = {});
+
+#endif // BATCH_BACKTEST_H
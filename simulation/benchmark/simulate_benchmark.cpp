@@ -0,0 +1,314 @@
+// Includes standard C++ libraries and project-specific headers
+#include "../market_data.h"
+#include "../dataset_cache.h"
+#include "../backtest.h"
+#include "../batch_backtest.h"
+#include "../sweep.h"
+#include "../timeline_backtest.h"
+#include "../price_bars.h"
+#include <bits/stdc++.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+using namespace chrono;
+
+// === Benchmark settings ===
+
+// Shape of the synthetic dataset and of the timed workload
+struct BenchmarkOptions
+{
+    size_t tickers = 200;           // Number of tickers with price history
+    size_t days = 30;               // Length of the history
+    size_t newsPerDay = 5000;       // News events per day across all tickers
+    size_t priceInterval = 300;     // Seconds between price records of a ticker
+    size_t simulations = 64;        // Strategies timed per kernel
+    size_t batchSize = 32;          // Strategies per batched-kernel pass
+    unsigned threads = thread::hardware_concurrency();
+    uint64_t seed = 1;
+    string dir = "benchmark_data";  // Where the synthetic CSVs and cache are written
+};
+
+// === Helpers ===
+
+// Seconds elapsed since `start`
+static double secondsSince(steady_clock::time_point start)
+{
+    return duration<double>(steady_clock::now() - start).count();
+}
+
+// Peak resident set size of this process in MiB
+static double peakRssMiB()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0.0;
+    return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+#else
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / (1024.0 * 1024.0);     // Bytes on macOS
+#else
+    return usage.ru_maxrss / 1024.0;                // KiB on Linux
+#endif
+#endif
+}
+
+// Prints one aligned "label: value unit" report line
+static void report(const string& label, double value, const string& unit, int decimals = 3)
+{
+    cout << "  " << left << setw(28) << label + ":" << right << setw(16) << fixed << setprecision(decimals)
+         << value << ' ' << unit << defaultfloat << endl;
+}
+
+// Formats seconds since the epoch as an ISO-8601 UTC timestamp
+static void formatTime(int64_t seconds, char* buf, size_t size)
+{
+    time_t t = static_cast<time_t>(seconds);
+    strftime(buf, size, "%Y-%m-%dT%H:%M:%S", gmtime(&t));
+}
+
+// Drops everything loaded into newsData and priceData
+static void clearMarketData()
+{
+    newsData.clear();
+    newsData.shrink_to_fit();
+    priceData = PriceStore();
+}
+
+// === Synthetic dataset ===
+
+// Writes news.csv and prices.csv into options.dir: a geometric random walk per
+// ticker sampled every priceInterval seconds, and news events at random times
+// with uniform sentiment. Returns the number of bytes written.
+static uintmax_t writeSyntheticDataset(const BenchmarkOptions& options)
+{
+    filesystem::create_directories(options.dir);
+    mt19937_64 rng(options.seed);
+    normal_distribution<double> step(0.0, 0.002);
+    uniform_real_distribution<double> startPrice(20.0, 300.0);
+    const int64_t start = 1704067200;       // 2024-01-01T00:00:00Z
+    const int64_t span = static_cast<int64_t>(options.days) * 86400;
+    char time[32];
+
+    vector<string> tickers;
+    for (size_t t = 0; t < options.tickers; ++t)
+    {
+        ostringstream name;
+        name << 'T' << setw(5) << setfill('0') << t;
+        tickers.push_back(name.str());
+    }
+
+    // Prices: one contiguous block per ticker, as the exporters write them
+    {
+        ofstream out(options.dir + "/prices.csv", ios::trunc);
+        for (auto const& ticker : tickers)
+        {
+            double price = startPrice(rng);
+            for (int64_t s = 0; s < span; s += options.priceInterval)
+            {
+                price *= 1.0 + step(rng);
+                formatTime(start + s, time, sizeof(time));
+                out << ticker << ',' << fixed << setprecision(4) << price << ',' << time << '\n';
+            }
+        }
+    }
+
+    // News: exponential gaps give the requested average rate; about one event
+    // in twenty mentions a ticker without prices
+    {
+        ofstream out(options.dir + "/news.csv", ios::trunc);
+        exponential_distribution<double> gap(options.newsPerDay / 86400.0);
+        uniform_int_distribution<size_t> pick(0, tickers.size() * 20 / 19);
+        uniform_real_distribution<double> similarity(0.4, 0.8);
+        uniform_real_distribution<double> sentiment(-1.0, 1.0);
+        for (double s = gap(rng); s < span; s += gap(rng))
+        {
+            size_t t = pick(rng);
+            string ticker = t < tickers.size() ? tickers[t] : "NOPRICE";
+            formatTime(start + static_cast<int64_t>(s), time, sizeof(time));
+            out << "Company " << ticker << ',' << ticker << ',' << fixed << setprecision(4)
+                << similarity(rng) << ',' << sentiment(rng) << ',' << time << "Z\n";
+        }
+    }
+
+    return filesystem::file_size(options.dir + "/prices.csv") +
+           filesystem::file_size(options.dir + "/news.csv");
+}
+
+// Strategies spread over the ranges of the built-in sweep
+static vector<GridPoint> benchmarkGrid(const BenchmarkOptions& options)
+{
+    mt19937_64 rng(options.seed);
+    uniform_real_distribution<double> invest(0.005, 0.05), buy(0.8, 0.9), sell(-0.5, -0.1), sim(0.5, 0.65);
+    vector<GridPoint> grid;
+    for (size_t i = 0; i < options.simulations; ++i)
+    {
+        grid.push_back({invest(rng), buy(rng), sell(rng), sim(rng)});
+    }
+    return grid;
+}
+
+// === Main: benchmark ===
+// Usage: simulate_benchmark [--tickers N] [--days N] [--news-per-day N] [--price-interval S]
+//                           [--simulations N] [--batch N] [--threads N] [--seed N] [--dir DIR]
+// Generates a synthetic dataset, then times loading it (CSV and mapped cache)
+// and running simulate(), the batched kernel, the threaded sweep, and the
+// timeline and bar kernels with stop-loss / take-profit exits over it.
+int main(int argc, char* argv[])
+{
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--tickers" && hasValue) options.tickers = stoul(argv[++i]);
+        else if (arg == "--days" && hasValue) options.days = stoul(argv[++i]);
+        else if (arg == "--news-per-day" && hasValue) options.newsPerDay = stoul(argv[++i]);
+        else if (arg == "--price-interval" && hasValue) options.priceInterval = max<size_t>(stoul(argv[++i]), 1);
+        else if (arg == "--simulations" && hasValue) options.simulations = max<size_t>(stoul(argv[++i]), 1);
+        else if (arg == "--batch" && hasValue) options.batchSize = max<size_t>(stoul(argv[++i]), 1);
+        else if (arg == "--threads" && hasValue) options.threads = static_cast<unsigned>(stoul(argv[++i]));
+        else if (arg == "--seed" && hasValue) options.seed = stoull(argv[++i]);
+        else if (arg == "--dir" && hasValue) options.dir = argv[++i];
+        else
+        {
+            cerr << "Usage: " << argv[0]
+                 << " [--tickers N] [--days N] [--news-per-day N] [--price-interval S]"
+                 << " [--simulations N] [--batch N] [--threads N] [--seed N] [--dir DIR]" << endl;
+            return 1;
+        }
+    }
+    if (options.threads == 0) options.threads = 1;
+    if (options.tickers == 0 || options.days == 0 || options.newsPerDay == 0)
+    {
+        cerr << "Tickers, days and news per day must be positive" << endl;
+        return 1;
+    }
+
+    cout << "Synthetic dataset: " << options.tickers << " tickers, " << options.days << " days, "
+         << options.newsPerDay << " news/day, prices every " << options.priceInterval << " s" << endl;
+
+    auto t0 = steady_clock::now();
+    double csvMiB = writeSyntheticDataset(options) / (1024.0 * 1024.0);
+    report("generate", secondsSince(t0), "s");
+
+    // --- Loading ---
+    cout << "Load:" << endl;
+    t0 = steady_clock::now();
+    loadNews(options.dir + "/news.csv", options.threads);
+    loadPrices(options.dir + "/prices.csv", options.threads);
+    double csvSeconds = secondsSince(t0);
+    size_t events = newsData.size();
+    size_t records = priceData.recordCount();
+    report("CSV load", csvSeconds, "s");
+    report("CSV throughput", csvMiB / csvSeconds, "MiB/s", 1);
+
+    string cachePath = options.dir + "/dataset.bin";
+    t0 = steady_clock::now();
+    if (!writeDatasetCache(cachePath)) return 1;
+    report("cache write", secondsSince(t0), "s");
+
+    clearMarketData();
+    t0 = steady_clock::now();
+    if (!loadDatasetCache(cachePath)) return 1;
+    report("cache map", secondsSince(t0), "s");
+
+    vector<GridPoint> grid = benchmarkGrid(options);
+    PriceLookupIndex lookup;
+    t0 = steady_clock::now();
+    lookup.build(holdDurationsOf(grid));
+    report("lookup index", secondsSince(t0), "s");
+
+    // --- Simulation ---
+    // events/s counts news events walked by all strategies together
+    auto reportRun = [&](const string& name, double seconds)
+    {
+        cout << name << ":" << endl;
+        report("time", seconds, "s");
+        report("simulations/s", grid.size() / seconds, "", 1);
+        report("events/s", static_cast<double>(events) * grid.size() / seconds, "", 0);
+    };
+
+    // simulate(), one strategy at a time on one thread
+    SimulationState state;
+    TradeStats stats;
+    double checksum = 0.0;
+    t0 = steady_clock::now();
+    for (auto const& p : grid)
+    {
+        int trades = 0, profitable = 0;
+        checksum += simulate(p.invest, p.buyT, p.sellT, p.simT, p.holdSecs, lookup, state,
+                             trades, profitable, stats);
+    }
+    reportRun("simulate()", secondsSince(t0));
+
+    // Batched kernel on one thread
+    SweepOptions sweep;
+    sweep.threads = 1;
+    sweep.batchSize = options.batchSize;
+    t0 = steady_clock::now();
+    vector<SweepResult> batched = runSweep(grid, lookup, sweep);
+    reportRun("simulateBatch() x" + to_string(options.batchSize), secondsSince(t0));
+
+    // Full sweep on every thread
+    sweep.threads = options.threads;
+    t0 = steady_clock::now();
+    vector<SweepResult> threaded = runSweep(grid, lookup, sweep);
+    reportRun("sweep on " + to_string(options.threads) + " threads", secondsSince(t0));
+
+    // The kernels must agree, otherwise the timings compare different work
+    double batchedSum = 0.0, threadedSum = 0.0;
+    for (auto const& r : batched) batchedSum += r.result;
+    for (auto const& r : threaded) threadedSum += r.result;
+    if (batchedSum != checksum || threadedSum != checksum)
+    {
+        cerr << "Kernel results disagree: " << checksum << " / " << batchedSum << " / " << threadedSum << endl;
+        return 1;
+    }
+
+    // Stop-loss / take-profit exits: the merged timeline walks every price tick,
+    // the bar kernel finds each position's exit in the bar hierarchy
+    sweep.threads = 1;
+    sweep.stopLoss = 0.03;
+    sweep.takeProfit = 0.05;
+    MarketTimeline timeline;
+    t0 = steady_clock::now();
+    timeline.build();
+    report("timeline merge", secondsSince(t0), "s");
+    sweep.timeline = &timeline;
+    t0 = steady_clock::now();
+    vector<SweepResult> walked = runSweep(grid, lookup, sweep);
+    reportRun("simulateTimeline() 3%/5%", secondsSince(t0));
+
+    PriceBarCache bars;
+    t0 = steady_clock::now();
+    bars.build();
+    report("price bars", secondsSince(t0), "s");
+    sweep.timeline = nullptr;
+    sweep.bars = &bars;
+    t0 = steady_clock::now();
+    vector<SweepResult> barred = runSweep(grid, lookup, sweep);
+    reportRun("simulateBars() 3%/5%", secondsSince(t0));
+
+    double walkedSum = 0.0, barredSum = 0.0;
+    for (auto const& r : walked) walkedSum += r.result;
+    for (auto const& r : barred) barredSum += r.result;
+    if (walkedSum != barredSum)
+    {
+        cerr << "Stop kernel results disagree: " << walkedSum << " / " << barredSum << endl;
+        return 1;
+    }
+
+    cout << "Totals:" << endl;
+    report("news events", static_cast<double>(events), "", 0);
+    report("price records", static_cast<double>(records), "", 0);
+    report("peak RSS", peakRssMiB(), "MiB", 1);
+    return 0;
+}
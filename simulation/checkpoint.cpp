@@ -0,0 +1,330 @@
+// Includes standard C++ libraries and project-specific headers
+#include "checkpoint.h"
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// Identifies a checkpoint file
+static const char CHECKPOINT_MAGIC[8] = {'N', 'D', 'T', 'C', 'H', 'K', 'P', 'T'};
+
+// Statistics accumulators are stored byte for byte
+static_assert(is_trivially_copyable<TradeStats>::value, "TradeStats must be trivially copyable");
+
+// === Checkpoint files ===
+
+// Reads a checkpoint. Returns false (with a message) if it is missing or unusable.
+bool loadCheckpoint(const string& path, SweepCheckpoint& checkpoint)
+{
+    ifstream in(path, ios::binary);
+    if (!in.is_open()) return false;
+
+    // Reads a raw value or array; false once the file runs out
+    auto get = [&](void* data, size_t bytes)
+    {
+        return static_cast<bool>(in.read(static_cast<char*>(data), bytes));
+    };
+
+    CheckpointHeader header;
+    if (!get(&header, sizeof(header)) || memcmp(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic)) != 0)
+    {
+        cerr << "Not a checkpoint: " << path << endl;
+        return false;
+    }
+    if (header.version != CHECKPOINT_VERSION)
+    {
+        cerr << "Checkpoint " << path << " has version " << header.version
+             << ", expected " << CHECKPOINT_VERSION << endl;
+        return false;
+    }
+
+    SweepCheckpoint loaded;
+    loaded.events = header.events;
+    loaded.lastTime = header.lastTime;
+    loaded.eventsAtLastTime = header.eventsAtLastTime;
+
+    // Ticker names
+    loaded.tickers.resize(header.tickerCount);
+    for (auto& name : loaded.tickers)
+    {
+        uint32_t length = 0;
+        if (!get(&length, sizeof(length)) || length > 4096)
+        {
+            cerr << "Checkpoint ticker table is corrupt: " << path << endl;
+            return false;
+        }
+        name.resize(length);
+        if (!get(name.data(), length))
+        {
+            cerr << "Checkpoint ticker table is corrupt: " << path << endl;
+            return false;
+        }
+    }
+
+    // Per grid point: fixed record, then its open positions
+    loaded.strategies.resize(header.strategyCount);
+    for (auto& s : loaded.strategies)
+    {
+        StrategyRecord r;
+        if (!get(&r, sizeof(r)))
+        {
+            cerr << "Checkpoint is truncated: " << path << endl;
+            return false;
+        }
+        s.params = {r.invest, r.buyT, r.sellT, r.simT, r.holdSecs};
+        s.balance = r.balance;
+        s.trades = r.trades;
+        s.profitable = r.profitable;
+        s.nextSeq = r.nextSeq;
+        s.stats = r.stats;
+
+        s.positions.resize(r.positionCount);
+        if (!get(s.positions.data(), r.positionCount * sizeof(CheckpointPosition)))
+        {
+            cerr << "Checkpoint is truncated: " << path << endl;
+            return false;
+        }
+        for (auto const& p : s.positions)
+        {
+            if (p.ticker >= header.tickerCount)
+            {
+                cerr << "Checkpoint position references unknown ticker: " << path << endl;
+                return false;
+            }
+        }
+    }
+
+    checkpoint = move(loaded);
+    return true;
+}
+
+// Writes a checkpoint through a temporary file next to `path`
+bool saveCheckpoint(const string& path, const SweepCheckpoint& checkpoint)
+{
+    string temporary = path + ".tmp";
+    {
+        ofstream out(temporary, ios::binary | ios::trunc);
+        if (!out.is_open())
+        {
+            cerr << "Failed to open checkpoint for writing: " << temporary << endl;
+            return false;
+        }
+
+        // Writes a raw value or array
+        auto put = [&](const void* data, size_t bytes) { out.write(static_cast<const char*>(data), bytes); };
+
+        CheckpointHeader header{};
+        memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(header.magic));
+        header.version = CHECKPOINT_VERSION;
+        header.tickerCount = static_cast<uint32_t>(checkpoint.tickers.size());
+        header.strategyCount = checkpoint.strategies.size();
+        header.events = checkpoint.events;
+        header.lastTime = checkpoint.lastTime;
+        header.eventsAtLastTime = checkpoint.eventsAtLastTime;
+        put(&header, sizeof(header));
+
+        for (auto const& name : checkpoint.tickers)
+        {
+            uint32_t length = static_cast<uint32_t>(name.size());
+            put(&length, sizeof(length));
+            put(name.data(), name.size());
+        }
+
+        for (auto const& s : checkpoint.strategies)
+        {
+            StrategyRecord r;
+            r.reserved = 0;
+            r.invest = s.params.invest;
+            r.buyT = s.params.buyT;
+            r.sellT = s.params.sellT;
+            r.simT = s.params.simT;
+            r.holdSecs = s.params.holdSecs;
+            r.trades = s.trades;
+            r.profitable = s.profitable;
+            r.balance = s.balance;
+            r.nextSeq = s.nextSeq;
+            r.positionCount = s.positions.size();
+            r.stats = s.stats;
+            put(&r, sizeof(r));
+            put(s.positions.data(), s.positions.size() * sizeof(CheckpointPosition));
+        }
+
+        out.flush();
+        if (!out.good())
+        {
+            cerr << "Failed to write checkpoint: " << temporary << endl;
+            return false;
+        }
+    }
+
+    error_code ec;
+    filesystem::rename(temporary, path, ec);
+    if (ec)
+    {
+        cerr << "Failed to replace checkpoint " << path << ": " << ec.message() << endl;
+        return false;
+    }
+    return true;
+}
+
+// === Resuming ===
+
+// True if the checkpoint holds exactly these grid points, in this order
+bool checkpointMatchesGrid(const SweepCheckpoint& checkpoint, const vector<GridPoint>& grid)
+{
+    if (checkpoint.strategies.size() != grid.size()) return false;
+    for (size_t i = 0; i < grid.size(); ++i)
+    {
+        const GridPoint& a = checkpoint.strategies[i].params;
+        const GridPoint& b = grid[i];
+        if (a.invest != b.invest || a.buyT != b.buyT || a.sellT != b.sellT ||
+            a.simT != b.simT || a.holdSecs != b.holdSecs)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Index of the first news event not covered by the checkpoint
+size_t resumeEvent(const SweepCheckpoint& checkpoint)
+{
+    if (checkpoint.events == 0) return 0;
+
+    // News is stably sorted by time, so appended events land after every old
+    // event with the same timestamp; the old events must still form a prefix
+    auto first = lower_bound(newsData.begin(), newsData.end(), checkpoint.lastTime,
+        [](const NewsEntry& n, int64_t t){ return n.timestamp < t; });
+    size_t resume = static_cast<size_t>(first - newsData.begin()) + checkpoint.eventsAtLastTime;
+    if (resume != checkpoint.events || resume > newsData.size() ||
+        newsData[resume - 1].timestamp != checkpoint.lastTime)
+    {
+        return newsData.size() + 1;
+    }
+    return resume;
+}
+
+// Runs every grid point over the news after the checkpoint from its saved state
+vector<SweepResult> runCheckpointedSweep(const vector<GridPoint>& grid, const PriceLookupIndex& lookup,
+                                         unsigned threads, SweepCheckpoint& checkpoint)
+{
+    if (checkpoint.strategies.empty())
+    {
+        checkpoint = SweepCheckpoint();
+        checkpoint.strategies.resize(grid.size());
+        for (size_t i = 0; i < grid.size(); ++i) checkpoint.strategies[i].params = grid[i];
+    }
+    else if (!checkpointMatchesGrid(checkpoint, grid))
+    {
+        throw invalid_argument("Checkpoint was written for a different parameter grid");
+    }
+    size_t first = resumeEvent(checkpoint);
+    if (first > newsData.size())
+    {
+        throw invalid_argument("Loaded news does not extend the checkpointed news");
+    }
+
+    // Checkpointed ticker names -> IDs of the loaded dataset
+    vector<TickerId> ids(checkpoint.tickers.size());
+    vector<bool> known(checkpoint.tickers.size());
+    for (size_t t = 0; t < checkpoint.tickers.size(); ++t)
+    {
+        known[t] = priceData.find(checkpoint.tickers[t], ids[t]);
+    }
+    for (auto const& s : checkpoint.strategies)
+    {
+        for (auto const& p : s.positions)
+        {
+            if (!known[p.ticker])
+            {
+                throw invalid_argument("Checkpoint holds " + checkpoint.tickers[p.ticker] +
+                                       ", which is not in the loaded dataset");
+            }
+        }
+    }
+
+    for (auto const& p : grid)
+    {
+        if (!lookup.exitsFor(p.holdSecs))
+        {
+            throw invalid_argument("Hold duration " + to_string(p.holdSecs) + "s is not in the price lookup index");
+        }
+    }
+
+    vector<SweepResult> results(grid.size());
+    unsigned workers = max(1u, min<unsigned>(threads, max<size_t>(grid.size(), 1)));
+    WorkStealingScheduler scheduler(grid.size(), workers);
+
+    auto worker = [&](unsigned w)
+    {
+        SimulationState state;      // Private open positions
+        size_t i;
+        while (scheduler.next(w, i))
+        {
+            StrategyCheckpoint& s = checkpoint.strategies[i];
+            const GridPoint& p = s.params;
+            ThresholdStrategy strategy = makeThresholdStrategy(p.invest, p.buyT, p.sellT, p.simT, p.holdSecs);
+            const uint64_t* exits = lookup.exitsFor(p.holdSecs);
+
+            // Reopen the saved positions. Forced-sell prices are looked up again,
+            // since record numbers change when prices are appended.
+            state.reset();
+            for (auto const& saved : s.positions)
+            {
+                TickerId id = ids[saved.ticker];
+                state.investmentMap[id].push_back({
+                    saved.seq, saved.quantity, saved.buyPrice, saved.buyTime,
+                    findPriceRecord(id, saved.buyTime + p.holdSecs)
+                });
+                state.expiries.push_back({strategy.expiry(saved.buyTime), saved.seq, id});
+            }
+            make_heap(state.expiries.begin(), state.expiries.end(), greater<ExpiryEntry>());
+            state.nextSeq = s.nextSeq;
+
+            LookupEvents events{lookup, exits, first, newsData.size()};
+            s.balance = resumeStrategy(strategy, events, state, s.balance, s.trades, s.profitable, s.stats);
+            s.nextSeq = state.nextSeq;
+
+            // Save what is still open, ticker by ticker in buy order
+            s.positions.clear();
+            for (TickerId id = 0; id < state.investmentMap.size(); ++id)
+            {
+                auto const& queue = state.investmentMap[id];
+                for (size_t k = queue.head; k < queue.nodes.size(); ++k)
+                {
+                    auto const& node = queue.nodes[k];
+                    s.positions.push_back({id, 0, node.seq, node.quantity, node.buyPrice, node.buyTime});
+                }
+            }
+
+            results[i] = summarizeRun(i, p, s.balance, s.trades, s.profitable, s.stats);
+        }
+    };
+
+    if (workers == 1)
+    {
+        worker(0);
+    }
+    else
+    {
+        vector<thread> pool;
+        for (unsigned w = 0; w < workers; ++w) pool.emplace_back(worker, w);
+        for (auto& t : pool) t.join();
+    }
+
+    // Positions now refer to the loaded dataset's ticker IDs
+    checkpoint.tickers.clear();
+    for (TickerId id = 0; id < priceData.tickerCount(); ++id)
+    {
+        checkpoint.tickers.push_back(priceData.tickerName(id));
+    }
+    if (!newsData.empty())
+    {
+        int64_t last = newsData.back().timestamp;
+        auto sameTime = lower_bound(newsData.begin(), newsData.end(), last,
+            [](const NewsEntry& n, int64_t t){ return n.timestamp < t; });
+        checkpoint.events = newsData.size();
+        checkpoint.lastTime = last;
+        checkpoint.eventsAtLastTime = static_cast<uint64_t>(newsData.end() - sameTime);
+    }
+    return results;
+}
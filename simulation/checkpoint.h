@@ -0,0 +1,108 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+// Includes standard C++ libraries and project-specific headers
+#include <bits/stdc++.h>
+#include "sweep.h"
+
+using namespace std;
+
+// === Sweep checkpoints ===
+//
+// The end state of every grid point after a sweep, so that a later sweep over
+// the same dataset with news and prices appended can resume instead of
+// replaying the whole history. Stored in host byte order:
+//
+//   CheckpointHeader                  magic, version, counts, resume position
+//   ticker names                      per ticker: uint32 length + bytes
+//   per grid point: StrategyRecord followed by CheckpointPosition[positionCount]
+//
+// A resumed sweep matches a full rerun as long as every forced sell that came
+// due before the checkpoint had a price. Positions whose forced-sell price was
+// still missing are sold at the first new event instead of in the past.
+
+// Bump whenever the layout or the meaning of a field changes
+constexpr uint32_t CHECKPOINT_VERSION = 1;
+
+// Fixed-size header at the start of a checkpoint file
+struct CheckpointHeader
+{
+    char magic[8];              // "NDTCHKPT"
+    uint32_t version;           // CHECKPOINT_VERSION of the writer
+    uint32_t tickerCount;       // Entries in the ticker name table
+    uint64_t strategyCount;     // Grid points stored
+    uint64_t events;            // News events processed so far
+    int64_t lastTime;           // Timestamp of the last processed event
+    uint64_t eventsAtLastTime;  // Processed events sharing lastTime
+};
+
+// One open position (in the ticker's buy order)
+struct CheckpointPosition
+{
+    uint32_t ticker;            // Index into the checkpoint's ticker names
+    uint32_t reserved;          // Padding, always zero
+    uint64_t seq;               // Run-unique position number
+    double quantity;            // Number of shares bought
+    double buyPrice;            // Price per share at purchase
+    int64_t buyTime;            // Time the position was opened
+};
+
+// Fixed-size part of one grid point's state on disk
+struct StrategyRecord
+{
+    double invest, buyT, sellT, simT;
+    int32_t holdSecs;
+    int32_t trades;
+    int32_t profitable;
+    int32_t reserved;           // Padding, always zero
+    double balance;
+    uint64_t nextSeq;
+    uint64_t positionCount;     // CheckpointPositions that follow
+    TradeStats stats;           // Accumulators, copied as-is
+};
+
+// End state of one grid point
+struct StrategyCheckpoint
+{
+    GridPoint params;                       // Strategy parameters
+    double balance = 10000.0;               // Cash balance
+    int trades = 0;                         // Buys so far
+    int profitable = 0;                     // Profitable sells so far
+    uint64_t nextSeq = 0;                   // Sequence number of the next position
+    TradeStats stats;                       // Statistics accumulators
+    vector<CheckpointPosition> positions;   // Open positions
+};
+
+// End state of a whole sweep
+struct SweepCheckpoint
+{
+    uint64_t events = 0;                    // News events processed so far
+    int64_t lastTime = 0;                   // Timestamp of the last processed event
+    uint64_t eventsAtLastTime = 0;          // Processed events sharing lastTime
+    vector<string> tickers;                 // Names behind CheckpointPosition::ticker
+    vector<StrategyCheckpoint> strategies;  // One per grid point, in grid order
+};
+
+// Reads a checkpoint. Returns false (with a message) if it is missing or unusable.
+bool loadCheckpoint(const string& path, SweepCheckpoint& checkpoint);
+
+// Writes a checkpoint through a temporary file, so an interrupted write never
+// replaces a good checkpoint. Returns false if it could not be written.
+bool saveCheckpoint(const string& path, const SweepCheckpoint& checkpoint);
+
+// True if the checkpoint holds exactly these grid points, in this order
+bool checkpointMatchesGrid(const SweepCheckpoint& checkpoint, const vector<GridPoint>& grid);
+
+// Index of the first news event not covered by the checkpoint, or
+// newsData.size() + 1 if the loaded news does not extend the checkpointed news
+// (events inserted before the checkpoint or a different dataset)
+size_t resumeEvent(const SweepCheckpoint& checkpoint);
+
+// Runs every grid point over the news after the checkpoint, starting from its
+// saved state, and stores the new end states back into `checkpoint`. An empty
+// checkpoint starts every point from scratch. `lookup` only needs the events
+// from the resume point on. Results are in grid order.
+vector<SweepResult> runCheckpointedSweep(const vector<GridPoint>& grid, const PriceLookupIndex& lookup,
+                                         unsigned threads, SweepCheckpoint& checkpoint);
+
+#endif // CHECKPOINT_H
@@ -0,0 +1,232 @@
+// Includes standard C++ libraries and project-specific headers
+#include "dataset_cache.h"
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// Identifies a dataset cache file
+static const char DATASET_MAGIC[8] = {'N', 'D', 'T', 'S', 'I', 'M', 'D', 'B'};
+
+// Rounds a byte offset up to the next multiple of 8
+static uint64_t align8(uint64_t offset)
+{
+    return (offset + 7) & ~uint64_t(7);
+}
+
+// === Writer ===
+
+// Writes the loaded newsData and priceData into a dataset cache at `path`
+bool writeDatasetCache(const string& path)
+{
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out.is_open())
+    {
+        cerr << "Failed to open dataset cache for writing: " << path << endl;
+        return false;
+    }
+
+    size_t tickers = priceData.tickerCount();
+
+    // Lay out the sections up front so the header can be written first
+    DatasetHeader header{};
+    memcpy(header.magic, DATASET_MAGIC, sizeof(header.magic));
+    header.version = DATASET_CACHE_VERSION;
+    header.tickerCount = static_cast<uint32_t>(tickers);
+    header.newsCount = newsData.size();
+    header.priceCount = priceData.recordCount();
+
+    uint64_t namesSize = 0;
+    for (TickerId id = 0; id < tickers; ++id)
+    {
+        namesSize += sizeof(uint32_t) + priceData.tickerName(id).size();
+    }
+
+    header.indexOffset = align8(sizeof(DatasetHeader));
+    header.namesOffset = header.indexOffset + (tickers + 1) * sizeof(uint64_t);
+    header.timestampsOffset = align8(header.namesOffset + namesSize);
+    header.pricesOffset = header.timestampsOffset + header.priceCount * sizeof(int64_t);
+    header.newsOffset = header.pricesOffset + header.priceCount * sizeof(double);
+    header.fileSize = header.newsOffset + header.newsCount * sizeof(DatasetNewsRecord);
+
+    // Writes a raw value or array and pads the stream to the given offset
+    auto put = [&](const void* data, size_t bytes) { out.write(static_cast<const char*>(data), bytes); };
+    auto padTo = [&](uint64_t offset)
+    {
+        static const char zeros[8] = {};
+        put(zeros, offset - static_cast<uint64_t>(out.tellp()));
+    };
+
+    put(&header, sizeof(header));
+    padTo(header.indexOffset);
+
+    // Block index: ticker blocks are written in ID order
+    uint64_t start = 0;
+    for (TickerId id = 0; id < tickers; ++id)
+    {
+        put(&start, sizeof(start));
+        start += priceData.series(id).size;
+    }
+    put(&start, sizeof(start));
+
+    // Ticker names
+    for (TickerId id = 0; id < tickers; ++id)
+    {
+        const string& name = priceData.tickerName(id);
+        uint32_t length = static_cast<uint32_t>(name.size());
+        put(&length, sizeof(length));
+        put(name.data(), name.size());
+    }
+    padTo(header.timestampsOffset);
+
+    // Each ticker block is sorted by time; the same order is reused for prices
+    vector<vector<uint32_t>> orders(tickers);
+    for (TickerId id = 0; id < tickers; ++id)
+    {
+        PriceSeries s = priceData.series(id);
+        auto& order = orders[id];
+        order.resize(s.size);
+        iota(order.begin(), order.end(), 0);
+        if (!is_sorted(s.timestamps, s.timestamps + s.size))
+        {
+            stable_sort(order.begin(), order.end(),
+                [&](uint32_t a, uint32_t b){ return s.timestamps[a] < s.timestamps[b]; });
+        }
+        for (uint32_t i : order) put(&s.timestamps[i], sizeof(int64_t));
+    }
+    for (TickerId id = 0; id < tickers; ++id)
+    {
+        PriceSeries s = priceData.series(id);
+        for (uint32_t i : orders[id]) put(&s.prices[i], sizeof(double));
+    }
+
+    // News records in chronological order
+    vector<uint32_t> newsOrder(newsData.size());
+    iota(newsOrder.begin(), newsOrder.end(), 0);
+    stable_sort(newsOrder.begin(), newsOrder.end(),
+        [](uint32_t a, uint32_t b){ return newsData[a].timestamp < newsData[b].timestamp; });
+    for (uint32_t i : newsOrder)
+    {
+        const NewsEntry& n = newsData[i];
+        DatasetNewsRecord record{n.tickerId, 0, n.similarity, n.sentiment, n.timestamp};
+        put(&record, sizeof(record));
+    }
+
+    out.flush();
+    if (!out.good() || static_cast<uint64_t>(out.tellp()) != header.fileSize)
+    {
+        cerr << "Failed to write dataset cache: " << path << endl;
+        return false;
+    }
+
+    cout << "Wrote dataset cache " << path << " (" << header.newsCount << " news entries, "
+         << header.priceCount << " price entries, " << tickers << " tickers)." << endl;
+    return true;
+}
+
+// === Loader ===
+
+// Maps a dataset cache and points newsData/priceData at it
+bool loadDatasetCache(const string& path)
+{
+    if (!filesystem::exists(path)) return false;
+
+    shared_ptr<MappedFile> file = MappedFile::open(path);
+    if (!file)
+    {
+        cerr << "Failed to map dataset cache: " << path << endl;
+        return false;
+    }
+
+    // Validate the header before trusting any offset in it
+    const char* base = file->data();
+    DatasetHeader header;
+    if (file->size() < sizeof(header))
+    {
+        cerr << "Dataset cache is truncated: " << path << endl;
+        return false;
+    }
+    memcpy(&header, base, sizeof(header));
+    if (memcmp(header.magic, DATASET_MAGIC, sizeof(header.magic)) != 0)
+    {
+        cerr << "Not a dataset cache: " << path << endl;
+        return false;
+    }
+    if (header.version != DATASET_CACHE_VERSION)
+    {
+        cerr << "Dataset cache " << path << " has version " << header.version
+             << ", expected " << DATASET_CACHE_VERSION << "; regenerate it with --convert" << endl;
+        return false;
+    }
+
+    uint64_t tickers = header.tickerCount;
+    bool layoutOk =
+        header.fileSize == file->size() &&
+        header.indexOffset + (tickers + 1) * sizeof(uint64_t) <= header.namesOffset &&
+        header.namesOffset <= header.timestampsOffset &&
+        header.timestampsOffset + header.priceCount * sizeof(int64_t) <= header.pricesOffset &&
+        header.pricesOffset + header.priceCount * sizeof(double) <= header.newsOffset &&
+        header.newsOffset + header.newsCount * sizeof(DatasetNewsRecord) <= header.fileSize &&
+        header.timestampsOffset % 8 == 0 && header.indexOffset % 8 == 0;
+    if (!layoutOk)
+    {
+        cerr << "Dataset cache is corrupt: " << path << endl;
+        return false;
+    }
+
+    // Block index must be monotonic and cover every price record
+    const uint64_t* index = reinterpret_cast<const uint64_t*>(base + header.indexOffset);
+    for (uint64_t i = 0; i < tickers; ++i)
+    {
+        if (index[i] > index[i + 1]) layoutOk = false;
+    }
+    if (!layoutOk || index[0] != 0 || index[tickers] != header.priceCount)
+    {
+        cerr << "Dataset cache index is corrupt: " << path << endl;
+        return false;
+    }
+
+    // Ticker names are small; copy them into strings
+    vector<string> names;
+    names.reserve(tickers);
+    const char* cursor = base + header.namesOffset;
+    const char* namesEnd = base + header.timestampsOffset;
+    for (uint64_t i = 0; i < tickers; ++i)
+    {
+        uint32_t length = 0;
+        if (cursor + sizeof(length) <= namesEnd) memcpy(&length, cursor, sizeof(length));
+        if (cursor + sizeof(length) + length > namesEnd)
+        {
+            cerr << "Dataset cache ticker table is corrupt: " << path << endl;
+            return false;
+        }
+        cursor += sizeof(length);
+        names.emplace_back(cursor, length);
+        cursor += length;
+    }
+
+    // News is copied (it is small next to the price history); prices stay mapped
+    vector<NewsEntry> news;
+    news.reserve(header.newsCount);
+    const char* records = base + header.newsOffset;
+    for (uint64_t i = 0; i < header.newsCount; ++i)
+    {
+        DatasetNewsRecord r;
+        memcpy(&r, records + i * sizeof(r), sizeof(r));
+        if (r.tickerId >= tickers)
+        {
+            cerr << "Dataset cache news record references unknown ticker: " << path << endl;
+            return false;
+        }
+        news.push_back({r.tickerId, r.similarity, r.sentiment, r.timestamp});
+    }
+
+    newsData = move(news);
+    priceData.attach(move(names), index,
+                     reinterpret_cast<const int64_t*>(base + header.timestampsOffset),
+                     reinterpret_cast<const double*>(base + header.pricesOffset),
+                     file);
+
+    cout << "Mapped dataset cache " << path << ": " << newsData.size() << " news entries, "
+         << priceData.recordCount() << " price entries." << endl;
+    return true;
+}
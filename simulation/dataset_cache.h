@@ -0,0 +1,63 @@
+#ifndef DATASET_CACHE_H
+#define DATASET_CACHE_H
+
+// Includes standard C++ libraries and project-specific headers
+#include <bits/stdc++.h>
+#include "market_data.h"
+#include "mapped_file.h"
+
+using namespace std;
+
+// === Binary dataset cache ===
+//
+// A one-time conversion of news.csv/prices.csv into a file that can be
+// memory-mapped and simulated on directly. All sections are 8-byte aligned
+// and stored in host byte order:
+//
+//   DatasetHeader                 magic, version, counts and section offsets
+//   uint64 index[tickers + 1]     first price record of each ticker block
+//   ticker names                  per ticker: uint32 length + bytes
+//   int64 timestamps[prices]      per-ticker blocks, each sorted by time
+//   double prices[prices]         same layout as the timestamps
+//   DatasetNewsRecord[news]       news events sorted by time
+
+// Bump whenever the layout or the meaning of a field changes
+// (2: timestamps are UTC instead of the converting machine's local time)
+constexpr uint32_t DATASET_CACHE_VERSION = 2;
+
+// Fixed-size header at the start of a dataset cache file
+struct DatasetHeader
+{
+    char magic[8];              // "NDTSIMDB"
+    uint32_t version;           // DATASET_CACHE_VERSION of the writer
+    uint32_t tickerCount;       // Number of interned tickers
+    uint64_t newsCount;         // Number of news records
+    uint64_t priceCount;        // Number of price records
+    uint64_t indexOffset;       // Byte offset of the per-ticker block index
+    uint64_t namesOffset;       // Byte offset of the ticker names
+    uint64_t timestampsOffset;  // Byte offset of the timestamp column
+    uint64_t pricesOffset;      // Byte offset of the price column
+    uint64_t newsOffset;        // Byte offset of the news records
+    uint64_t fileSize;          // Total file size, used to detect truncation
+};
+
+// On-disk news event (mirrors NewsEntry with explicit padding)
+struct DatasetNewsRecord
+{
+    uint32_t tickerId;          // Index into the ticker table
+    uint32_t reserved;          // Padding, always zero
+    double similarity;          // Similarity to company's profile
+    double sentiment;           // Sentiment score of the news
+    int64_t timestamp;          // Seconds since the epoch
+};
+
+// Writes the loaded newsData and priceData into a dataset cache at `path`.
+// Price blocks and news are sorted by time on the way out.
+// Returns false if the file could not be written.
+bool writeDatasetCache(const string& path);
+
+// Maps a dataset cache and points newsData/priceData at it.
+// Returns false, leaving both untouched, if the file is missing or unusable.
+bool loadDatasetCache(const string& path);
+
+#endif // DATASET_CACHE_H
@@ -0,0 +1,34 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+// Includes standard C++ libraries
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// === Memory-mapped files ===
+
+// Read-only memory mapping of a whole file
+class MappedFile
+{
+public:
+    // Maps a file; returns nullptr if it cannot be opened or mapped
+    static shared_ptr<MappedFile> open(const string& path);
+
+    ~MappedFile();
+
+    const char* data() const { return base; }
+    size_t size() const { return length; }
+
+private:
+    MappedFile() = default;
+
+    const char* base = nullptr;     // Start of the mapping
+    size_t length = 0;              // Mapped size in bytes
+#ifdef _WIN32
+    void* fileHandle = nullptr;     // HANDLE of the opened file
+    void* mappingHandle = nullptr;  // HANDLE of the file mapping
+#endif
+};
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,473 @@
+// Includes standard C++ libraries and project-specific headers
+#include "market_data.h"
+#include "mapped_file.h"
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// === Global market data ===
+
+// Columnar historical price records for every ticker
+PriceStore priceData;
+
+// Sequence of news events to feed into the simulation
+vector<NewsEntry> newsData;
+
+// === PriceStore ===
+
+// Returns the ID of a ticker, assigning the next free ID if it is new
+TickerId PriceStore::intern(const string& ticker)
+{
+    auto [it, inserted] = ids.emplace(ticker, static_cast<TickerId>(names.size()));
+    if (inserted)
+    {
+        names.push_back(ticker);
+    }
+    return it->second;
+}
+
+// Looks a ticker up without inserting it; returns false if it is unknown
+bool PriceStore::find(const string& ticker, TickerId& id) const
+{
+    auto it = ids.find(ticker);
+    if (it == ids.end()) return false;
+    id = it->second;
+    return true;
+}
+
+// Reserves room for `count` more appended records
+void PriceStore::reserve(size_t count)
+{
+    pendingIds.reserve(timestamps.size() + count);
+    timestamps.reserve(timestamps.size() + count);
+    prices.reserve(prices.size() + count);
+}
+
+// Appends a price record while loading; call finalize() once loading is done
+void PriceStore::append(TickerId id, int64_t timestamp, double price)
+{
+    // Borrowed columns are read-only
+    if (backing)
+    {
+        throw logic_error("Cannot append prices to a store attached to external data");
+    }
+
+    // Records packed by an earlier finalize() need their IDs back before repacking
+    if (pendingIds.size() < timestamps.size())
+    {
+        pendingIds.clear();
+        for (TickerId t = 0; t + 1 < offsets.size(); ++t)
+        {
+            pendingIds.insert(pendingIds.end(), offsets[t + 1] - offsets[t], t);
+        }
+    }
+
+    pendingIds.push_back(id);
+    timestamps.push_back(timestamp);
+    prices.push_back(price);
+}
+
+// Packs all appended records into per-ticker contiguous columns sorted by time.
+// A stable counting sort by ticker ID keeps each ticker's records in load order.
+void PriceStore::finalize()
+{
+    // Count records per ticker and turn the counts into start offsets
+    offsets.assign(names.size() + 1, 0);
+    for (TickerId id : pendingIds)
+    {
+        ++offsets[id + 1];
+    }
+    for (size_t i = 1; i < offsets.size(); ++i)
+    {
+        offsets[i] += offsets[i - 1];
+    }
+
+    // Scatter every record into its ticker's block
+    vector<uint64_t> cursor(offsets.begin(), offsets.end() - 1);
+    vector<int64_t> packedTimes(timestamps.size());
+    vector<double> packedPrices(prices.size());
+    for (size_t i = 0; i < pendingIds.size(); ++i)
+    {
+        uint64_t dst = cursor[pendingIds[i]]++;
+        packedTimes[dst] = timestamps[i];
+        packedPrices[dst] = prices[i];
+    }
+
+    // Order each block by time; exports are usually sorted already, so only
+    // blocks that are not get sorted (stably, keeping load order for equal times)
+    vector<pair<int64_t, double>> block;
+    for (size_t t = 0; t + 1 < offsets.size(); ++t)
+    {
+        auto first = packedTimes.begin() + offsets[t];
+        auto last = packedTimes.begin() + offsets[t + 1];
+        if (is_sorted(first, last)) continue;
+
+        block.clear();
+        for (uint64_t i = offsets[t]; i < offsets[t + 1]; ++i)
+        {
+            block.push_back({packedTimes[i], packedPrices[i]});
+        }
+        stable_sort(block.begin(), block.end(),
+                    [](auto const& a, auto const& b){ return a.first < b.first; });
+        for (size_t k = 0; k < block.size(); ++k)
+        {
+            packedTimes[offsets[t] + k] = block[k].first;
+            packedPrices[offsets[t] + k] = block[k].second;
+        }
+    }
+
+    timestamps.swap(packedTimes);
+    prices.swap(packedPrices);
+    pendingIds.clear();
+    pendingIds.shrink_to_fit();
+    useOwnedColumns();
+}
+
+// Replaces the store's contents with borrowed columns (e.g. a mapped dataset)
+void PriceStore::attach(vector<string> tickerNames,
+                        const uint64_t* offsetColumn,
+                        const int64_t* timeColumn,
+                        const double* priceColumn,
+                        shared_ptr<const void> buffer)
+{
+    names = move(tickerNames);
+    ids.clear();
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        ids.emplace(names[i], static_cast<TickerId>(i));
+    }
+
+    // Drop any owned records; the borrowed columns take their place
+    offsets.clear();
+    timestamps.clear();
+    prices.clear();
+    pendingIds.clear();
+
+    backing = move(buffer);
+    offsetView = offsetColumn;
+    timeView = timeColumn;
+    priceView = priceColumn;
+    offsetCount = names.size();
+    records = names.empty() ? 0 : offsetColumn[names.size()];
+}
+
+// Points the column views at the owned vectors
+void PriceStore::useOwnedColumns()
+{
+    offsetView = offsets.data();
+    timeView = timestamps.data();
+    priceView = prices.data();
+    offsetCount = offsets.empty() ? 0 : offsets.size() - 1;
+    records = timestamps.size();
+}
+
+// === Parsing helpers ===
+
+// Files smaller than this per thread are not worth splitting further
+static constexpr size_t MIN_CHUNK_BYTES = 1 << 20;
+
+// Days from 1970-01-01 to a proleptic Gregorian date (month 1-12)
+static int64_t daysFromCivil(int64_t y, unsigned m, unsigned d)
+{
+    y -= m <= 2;
+    int64_t era = (y >= 0 ? y : y - 399) / 400;
+    unsigned yoe = static_cast<unsigned>(y - era * 400);
+    unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+// Reads exactly `digits` decimal digits at p[0..digits); false if any is not a digit
+static bool readDigits(const char* p, int digits, int& value)
+{
+    value = 0;
+    for (int k = 0; k < digits; ++k)
+    {
+        if (p[k] < '0' || p[k] > '9') return false;
+        value = value * 10 + (p[k] - '0');
+    }
+    return true;
+}
+
+// Strips spaces and a trailing carriage return
+static string_view trimField(string_view s)
+{
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+    return s;
+}
+
+// Parses a whole field as a double
+static bool parseDouble(string_view s, double& value)
+{
+    s = trimField(s);
+    if (!s.empty() && s.front() == '+') s.remove_prefix(1);
+    if (s.empty()) return false;
+    auto [end, ec] = from_chars(s.data(), s.data() + s.size(), value);
+    return ec == errc() && end == s.data() + s.size();
+}
+
+// Splits the next comma-separated field off the front of `line`.
+// With last = true the rest of the line is the field.
+static bool nextField(string_view& line, string_view& field, bool last = false)
+{
+    size_t comma = last ? string_view::npos : line.find(',');
+    if (!last && comma == string_view::npos) return false;
+    field = trimField(line.substr(0, comma));
+    line = last ? string_view() : line.substr(comma + 1);
+    return true;
+}
+
+// Splits [0, size) into up to `parts` byte ranges that each start at the
+// beginning of a line and end just after a newline (or at the end of the file)
+static vector<pair<size_t, size_t>> lineAlignedChunks(const char* data, size_t size, unsigned parts)
+{
+    parts = max(1u, min<unsigned>(parts, size / MIN_CHUNK_BYTES + 1));
+    vector<pair<size_t, size_t>> chunks;
+    size_t begin = 0;
+    for (unsigned k = 1; k <= parts && begin < size; ++k)
+    {
+        size_t end = size * k / parts;
+        if (k == parts) end = size;
+        else
+        {
+            // Move the cut past the next newline so no line is split
+            end = max(end, begin);
+            const void* nl = memchr(data + end, '\n', size - end);
+            end = nl ? static_cast<const char*>(nl) - data + 1 : size;
+        }
+        if (end > begin) chunks.push_back({begin, end});
+        begin = end;
+    }
+    return chunks;
+}
+
+// Ticker symbols seen by one chunk, numbered in first-seen order. Symbols are
+// views into the mapped file, so nothing is copied until the merge.
+struct ChunkTickers
+{
+    unordered_map<string_view, TickerId> ids;
+    vector<string_view> names;
+
+    TickerId intern(string_view ticker)
+    {
+        auto [it, inserted] = ids.emplace(ticker, static_cast<TickerId>(names.size()));
+        if (inserted) names.push_back(ticker);
+        return it->second;
+    }
+
+    // Maps chunk-local IDs onto priceData's IDs. Merging chunks in file order
+    // assigns global IDs in the same first-seen order as a sequential load.
+    vector<TickerId> globalIds() const
+    {
+        vector<TickerId> remap;
+        for (auto name : names) remap.push_back(priceData.intern(string(name)));
+        return remap;
+    }
+};
+
+// Parses every line of a mapped file on up to `threads` threads. Each chunk of
+// lines is handled by parseLine(chunk, line) into its own Chunk; chunks are
+// returned in file order.
+template<typename Chunk, typename ParseLine>
+static vector<Chunk> parseLines(const MappedFile& file, unsigned threads, ParseLine parseLine)
+{
+    if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+    auto ranges = lineAlignedChunks(file.data(), file.size(), threads);
+    vector<Chunk> chunks(ranges.size());
+
+    auto work = [&](size_t c)
+    {
+        string_view text(file.data() + ranges[c].first, ranges[c].second - ranges[c].first);
+        while (!text.empty())
+        {
+            size_t nl = text.find('\n');
+            string_view line = text.substr(0, nl);
+            text = nl == string_view::npos ? string_view() : text.substr(nl + 1);
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            if (line.empty()) continue;
+            parseLine(chunks[c], line);
+        }
+    };
+
+    vector<thread> pool;
+    for (size_t c = 1; c < chunks.size(); ++c) pool.emplace_back(work, c);
+    if (!chunks.empty()) work(0);
+    for (auto& t : pool) t.join();
+    return chunks;
+}
+
+// === Loading functions ===
+
+// Parses an ISO-8601 timestamp ("YYYY-MM-DDTHH:MM:SS", optional fraction and
+// Z/+HH:MM/-HH:MM suffix) into seconds since the epoch. Times without an
+// offset are taken as UTC.
+bool parseTime(string_view iso, int64_t& seconds)
+{
+    iso = trimField(iso);
+    int y, mo, d, h, mi, s;
+    if (iso.size() < 19 || iso[4] != '-' || iso[7] != '-' ||
+        (iso[10] != 'T' && iso[10] != ' ') || iso[13] != ':' || iso[16] != ':')
+    {
+        return false;
+    }
+    const char* p = iso.data();
+    if (!readDigits(p, 4, y) || !readDigits(p + 5, 2, mo) || !readDigits(p + 8, 2, d) ||
+        !readDigits(p + 11, 2, h) || !readDigits(p + 14, 2, mi) || !readDigits(p + 17, 2, s) ||
+        mo < 1 || mo > 12 || d < 1 || d > 31 || h > 23 || mi > 59 || s > 60)
+    {
+        return false;
+    }
+
+    // Skip fractional seconds, then apply the UTC offset if there is one
+    size_t i = 19;
+    if (i < iso.size() && iso[i] == '.')
+    {
+        ++i;
+        while (i < iso.size() && iso[i] >= '0' && iso[i] <= '9') ++i;
+    }
+    int64_t offset = 0;
+    if (i < iso.size() && iso[i] == 'Z')
+    {
+        ++i;
+    }
+    else if (i < iso.size() && (iso[i] == '+' || iso[i] == '-'))
+    {
+        int oh, om = 0;
+        if (iso.size() < i + 3 || !readDigits(p + i + 1, 2, oh)) return false;
+        size_t j = i + 3;
+        if (j < iso.size() && iso[j] == ':') ++j;
+        if (j < iso.size())
+        {
+            if (iso.size() < j + 2 || !readDigits(p + j, 2, om)) return false;
+            j += 2;
+        }
+        offset = (iso[i] == '-' ? -1 : 1) * (oh * 3600 + om * 60);
+        i = j;
+    }
+    if (i != iso.size()) return false;
+
+    seconds = daysFromCivil(y, mo, d) * 86400 + h * 3600 + mi * 60 + s - offset;
+    return true;
+}
+
+// Reads a CSV of news entries (name,ticker,similarity,sentiment,time) in
+// parallel chunks and appends them to newsData in time order
+void loadNews(const string& file, unsigned threads)
+{
+    shared_ptr<MappedFile> mapped = MappedFile::open(file);
+    if (!mapped)
+    {
+        cerr << "Failed to open news file!" << endl;
+        return;
+    }
+
+    // Events of one chunk with chunk-local ticker IDs
+    struct NewsChunk
+    {
+        ChunkTickers tickers;
+        vector<NewsEntry> entries;
+        vector<string_view> malformed;
+    };
+
+    auto chunks = parseLines<NewsChunk>(*mapped, threads, [](NewsChunk& chunk, string_view line)
+    {
+        string_view rest = line, name, ticker, sim, sent, time;
+        NewsEntry entry;
+        if (!nextField(rest, name) || !nextField(rest, ticker) || !nextField(rest, sim) ||
+            !nextField(rest, sent) || !nextField(rest, time, true) || ticker.empty() ||
+            !parseDouble(sim, entry.similarity) || !parseDouble(sent, entry.sentiment) ||
+            !parseTime(time, entry.timestamp))
+        {
+            chunk.malformed.push_back(line);
+            return;
+        }
+        entry.tickerId = chunk.tickers.intern(ticker);
+        chunk.entries.push_back(entry);
+    });
+
+    // Merge in file order, translating ticker IDs
+    size_t count = 0;
+    size_t firstNew = newsData.size();
+    for (auto& chunk : chunks)
+    {
+        for (auto line : chunk.malformed)
+        {
+            cerr << "Skipping malformed line: " << line << endl;
+        }
+        vector<TickerId> remap = chunk.tickers.globalIds();
+        for (auto& entry : chunk.entries)
+        {
+            entry.tickerId = remap[entry.tickerId];
+            newsData.push_back(entry);
+        }
+        count += chunk.entries.size();
+    }
+
+    // The simulation walks events chronologically; equal times keep file order
+    auto byTime = [](const NewsEntry& a, const NewsEntry& b){ return a.timestamp < b.timestamp; };
+    if (!is_sorted(newsData.begin() + firstNew, newsData.end(), byTime))
+    {
+        stable_sort(newsData.begin() + firstNew, newsData.end(), byTime);
+    }
+
+    cout << "Loaded " << count << " news entries." << endl;
+}
+
+// Reads a CSV of price entries (ticker,price,time) in parallel chunks and
+// packs them into priceData, each ticker's records sorted by time
+void loadPrices(const string& file, unsigned threads)
+{
+    shared_ptr<MappedFile> mapped = MappedFile::open(file);
+    if (!mapped)
+    {
+        cerr << "Failed to open prices file!" << endl;
+        return;
+    }
+
+    // Records of one chunk with chunk-local ticker IDs
+    struct PriceChunk
+    {
+        ChunkTickers tickers;
+        vector<TickerId> ids;
+        vector<int64_t> times;
+        vector<double> prices;
+        vector<string_view> malformed;
+    };
+
+    auto chunks = parseLines<PriceChunk>(*mapped, threads, [](PriceChunk& chunk, string_view line)
+    {
+        string_view rest = line, ticker, price, time;
+        double value;
+        int64_t seconds;
+        if (!nextField(rest, ticker) || !nextField(rest, price) || !nextField(rest, time, true) ||
+            ticker.empty() || !parseDouble(price, value) || !parseTime(time, seconds))
+        {
+            chunk.malformed.push_back(line);
+            return;
+        }
+        chunk.ids.push_back(chunk.tickers.intern(ticker));
+        chunk.times.push_back(seconds);
+        chunk.prices.push_back(value);
+    });
+
+    // Merge in file order, translating ticker IDs; finalize() sorts by time
+    size_t count = 0;
+    for (auto const& chunk : chunks) count += chunk.ids.size();
+    priceData.reserve(count);
+    for (auto const& chunk : chunks)
+    {
+        for (auto line : chunk.malformed)
+        {
+            cerr << "Skipping malformed line: " << line << endl;
+        }
+        vector<TickerId> remap = chunk.tickers.globalIds();
+        for (size_t i = 0; i < chunk.ids.size(); ++i)
+        {
+            priceData.append(remap[chunk.ids[i]], chunk.times[i], chunk.prices[i]);
+        }
+    }
+    priceData.finalize();
+
+    cout << "Loaded " << count << " price entries." << endl;
+}
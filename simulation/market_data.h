@@ -0,0 +1,141 @@
+#ifndef MARKET_DATA_H
+#define MARKET_DATA_H
+
+// Includes most standard C++ libraries
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// === Market data used by the simulator ===
+
+// Dense integer ID assigned to each ticker when it is first seen at load time
+using TickerId = uint32_t;
+
+// Represents a news event with associated company ticker, text similarity score,
+// sentiment score, and publication timestamp
+struct NewsEntry
+{
+    TickerId tickerId;      // Interned stock symbol associated with the news
+    double similarity;      // Similarity to company's profile
+    double sentiment;       // Sentiment score of the news
+    int64_t timestamp;      // Publication time in seconds since the epoch
+};
+
+// Read-only view over one ticker's packed price columns (sorted by time)
+struct PriceSeries
+{
+    const int64_t* timestamps;  // Record times in seconds since the epoch
+    const double* prices;       // Price of the record at the same position
+    size_t size;                // Number of records
+
+    // Index of the first record at or after time t (size if there is none)
+    size_t lowerBound(int64_t t) const
+    {
+        return lower_bound(timestamps, timestamps + size, t) - timestamps;
+    }
+};
+
+// Columnar price history for all tickers.
+// Ticker symbols are interned to dense IDs; the records of each ticker are stored
+// contiguously in two shared columns (timestamps and prices) addressed by offsets.
+// The columns are either owned by the store (CSV loading) or borrowed from an
+// external buffer such as a memory-mapped dataset cache (see attach()).
+class PriceStore
+{
+public:
+    // Returns the ID of a ticker, assigning the next free ID if it is new
+    TickerId intern(const string& ticker);
+
+    // Looks a ticker up without inserting it; returns false if it is unknown
+    bool find(const string& ticker, TickerId& id) const;
+
+    // Symbol of an interned ticker
+    const string& tickerName(TickerId id) const { return names[id]; }
+
+    // Number of interned tickers (including tickers without any price records)
+    size_t tickerCount() const { return names.size(); }
+
+    // Total number of price records across all tickers
+    size_t recordCount() const { return records; }
+
+    // Reserves room for `count` more appended records
+    void reserve(size_t count);
+
+    // Appends a price record while loading; call finalize() once loading is done
+    void append(TickerId id, int64_t timestamp, double price);
+
+    // Packs all appended records into per-ticker contiguous columns sorted by time
+    void finalize();
+
+    // Replaces the store's contents with borrowed columns laid out like the packed
+    // store: offsets has tickerNames.size() + 1 entries. `backing` keeps the
+    // underlying buffer alive for as long as the store references it.
+    void attach(vector<string> tickerNames,
+                const uint64_t* offsetColumn,
+                const int64_t* timeColumn,
+                const double* priceColumn,
+                shared_ptr<const void> backing);
+
+    // Global record number of the first record of a ticker
+    uint64_t recordOffset(TickerId id) const { return id < offsetCount ? offsetView[id] : 0; }
+
+    // Price of a record by its global record number
+    double recordPrice(uint64_t record) const { return priceView[record]; }
+
+    // Time of a record by its global record number
+    int64_t recordTime(uint64_t record) const { return timeView[record]; }
+
+    // Price columns of one ticker (empty for tickers without records)
+    PriceSeries series(TickerId id) const
+    {
+        if (id >= offsetCount) return {nullptr, nullptr, 0};
+        size_t begin = offsetView[id];
+        return {timeView + begin, priceView + begin, offsetView[id + 1] - begin};
+    }
+
+private:
+    // Points the column views at the owned vectors
+    void useOwnedColumns();
+
+    vector<string> names;                   // Ticker symbol per ID
+    unordered_map<string, TickerId> ids;    // Ticker symbol -> ID
+
+    vector<uint64_t> offsets;               // Start of each ticker's records; offsets[n] = total
+    vector<int64_t> timestamps;             // Packed timestamp column
+    vector<double> prices;                  // Packed price column
+
+    vector<TickerId> pendingIds;            // Ticker of each record appended since finalize()
+
+    const uint64_t* offsetView = nullptr;   // Active offset column (owned or borrowed)
+    const int64_t* timeView = nullptr;      // Active timestamp column
+    const double* priceView = nullptr;      // Active price column
+    size_t offsetCount = 0;                 // Number of tickers covered by offsetView
+    size_t records = 0;                     // Number of records in the active columns
+    shared_ptr<const void> backing;         // Keeps a borrowed buffer alive
+};
+
+// === Global market data ===
+
+// Columnar historical price records for every ticker
+extern PriceStore priceData;
+
+// Sequence of news events to feed into the simulation
+extern vector<NewsEntry> newsData;
+
+// === Loading functions ===
+
+// Parses an ISO-8601 timestamp ("YYYY-MM-DDTHH:MM:SS", optional fraction and
+// Z/+HH:MM/-HH:MM suffix) into seconds since the epoch; times without an offset
+// are UTC. Returns false if the text is not such a timestamp.
+bool parseTime(string_view iso, int64_t& seconds);
+
+// Reads a CSV of news entries into newsData, sorted by time. The file is
+// mapped and split into line-aligned chunks parsed on `threads` threads
+// (0 = all hardware threads); malformed lines are reported and skipped.
+void loadNews(const string& file, unsigned threads = 0);
+
+// Reads a CSV of price entries into priceData the same way; each ticker's
+// records are sorted by time
+void loadPrices(const string& file, unsigned threads = 0);
+
+#endif // MARKET_DATA_H
@@ -0,0 +1,182 @@
+// Includes standard C++ libraries and project-specific headers
+#include "monte_carlo.h"
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// === Random streams ===
+
+// SplitMix64 step, used to derive independent seeds from (seed, run)
+static uint64_t splitMix64(uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// === Path construction ===
+
+// Rebuilds `path` as one resampled version of newsData
+static void buildPath(MonteCarloPath& path, const MonteCarloConfig& cfg, int holdSecs,
+                      const uint64_t* exits, const PriceLookupIndex& lookup, mt19937_64& rng)
+{
+    path.events.clear();
+    size_t n = newsData.size();
+    if (n == 0) return;
+
+    uniform_real_distribution<double> unit(0.0, 1.0);
+    int64_t jitterSeconds = max<int64_t>(cfg.jitterSeconds, 0);
+    uniform_int_distribution<int64_t> jitter(-jitterSeconds, jitterSeconds);
+    int64_t first = newsData.front().timestamp;
+    int64_t span = newsData.back().timestamp - first;
+    int64_t meanGap = n > 1 ? span / static_cast<int64_t>(n - 1) : 0;
+    bool resampled = cfg.blockSize > 0 || cfg.jitterSeconds > 0;
+
+    // Appends source event i at timeline position t (after the drop test)
+    auto emit = [&](size_t i, int64_t t)
+    {
+        if (cfg.dropProbability > 0 && unit(rng) < cfg.dropProbability) return;
+
+        MonteCarloPath::Event e{t, static_cast<uint32_t>(path.events.size()), i,
+                                lookup.entry[i], exits[i]};
+        if (cfg.jitterSeconds > 0)
+        {
+            // Prices follow the event to its jittered time in the real history
+            int64_t shift = jitter(rng);
+            const NewsEntry& news = newsData[i];
+            e.time += shift;
+            e.entry = findPriceRecord(news.tickerId, news.timestamp + shift);
+            e.exit = findPriceRecord(news.tickerId, news.timestamp + shift + holdSecs);
+        }
+
+        // Only news from the last holdSecs of price history lacks an exit price. In
+        // history order it sits at the end, but anywhere else a position bought on
+        // it could never be force-sold and would hold up every later position of
+        // its ticker, so a resampled path leaves such events out
+        if (resampled && e.exit == PriceLookupIndex::NO_PRICE) return;
+        path.events.push_back(e);
+    };
+
+    if (cfg.blockSize == 0)
+    {
+        for (size_t i = 0; i < n; ++i) emit(i, newsData[i].timestamp);
+    }
+    else
+    {
+        // Circular block bootstrap: blocks of consecutive events from random
+        // starts, laid end to end on a new timeline with their inner gaps kept
+        uniform_int_distribution<size_t> start(0, n - 1);
+        int64_t cursor = first;
+        for (size_t drawn = 0; drawn < n; )
+        {
+            size_t s = start(rng);
+            size_t len = min(cfg.blockSize, n - drawn);
+            int64_t base = newsData[s].timestamp;
+            int64_t t = cursor;
+            for (size_t k = 0; k < len; ++k)
+            {
+                size_t i = (s + k) % n;
+                int64_t wrap = s + k >= n ? span + meanGap : 0;
+                t = cursor + newsData[i].timestamp + wrap - base;
+                emit(i, t);
+            }
+            cursor = t + meanGap;
+            drawn += len;
+        }
+    }
+
+    // Jitter can reorder neighbouring events
+    if (cfg.jitterSeconds > 0)
+    {
+        sort(path.events.begin(), path.events.end(), [](auto const& a, auto const& b)
+        {
+            return a.time != b.time ? a.time < b.time : a.slot < b.slot;
+        });
+    }
+}
+
+// === Monte Carlo runs ===
+
+// Value at quantile q of sorted values (nearest rank)
+static double percentile(const vector<double>& sorted, double q)
+{
+    if (sorted.empty()) return 0.0;
+    size_t rank = static_cast<size_t>(ceil(q * sorted.size()));
+    return sorted[min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+// Simulates one candidate on cfg.runs resampled timelines
+MonteCarloSummary runMonteCarlo(const GridPoint& params, const PriceLookupIndex& lookup,
+                                const MonteCarloConfig& cfg, unsigned threads)
+{
+    const uint64_t* exits = lookup.exitsFor(params.holdSecs);
+    if (!exits)
+    {
+        throw invalid_argument("Hold duration " + to_string(params.holdSecs) + "s is not in the price lookup index");
+    }
+    ThresholdStrategy strategy = makeThresholdStrategy(params.invest, params.buyT, params.sellT,
+                                                       params.simT, params.holdSecs);
+
+    // Results land in run order, so the summary does not depend on scheduling
+    vector<double> balances(cfg.runs), accuracies(cfg.runs);
+    atomic<size_t> nextRun{0};
+    auto worker = [&]()
+    {
+        // Everything a run touches is reused, so steady-state runs do not allocate
+        SimulationState state;
+        TradeStats stats;
+        MonteCarloPath path;
+        path.events.reserve(newsData.size());
+        for (size_t run = nextRun++; run < cfg.runs; run = nextRun++)
+        {
+            mt19937_64 rng(splitMix64(cfg.seed ^ splitMix64(run)));
+            buildPath(path, cfg, params.holdSecs, exits, lookup, rng);
+
+            int trades = 0, profitable = 0;
+            balances[run] = runStrategy(strategy, path, state, trades, profitable, stats);
+            accuracies[run] = trades ? static_cast<double>(profitable) / trades * 100.0 : 0.0;
+        }
+    };
+
+    unsigned workers = max(1u, min<unsigned>(threads, cfg.runs));
+    if (workers == 1)
+    {
+        worker();
+    }
+    else
+    {
+        vector<thread> pool;
+        for (unsigned w = 0; w < workers; ++w) pool.emplace_back(worker);
+        for (auto& t : pool) t.join();
+    }
+
+    MonteCarloSummary s;
+    s.params = params;
+    s.runs = cfg.runs;
+    if (cfg.runs == 0) return s;
+
+    double sum = 0.0, accuracySum = 0.0;
+    size_t profitableRuns = 0;
+    for (size_t r = 0; r < cfg.runs; ++r)
+    {
+        sum += balances[r];
+        accuracySum += accuracies[r];
+        if (balances[r] > 10000.0) ++profitableRuns;
+    }
+    s.meanBalance = sum / cfg.runs;
+    double squares = 0.0;
+    for (double b : balances) squares += (b - s.meanBalance) * (b - s.meanBalance);
+    s.stdBalance = cfg.runs > 1 ? sqrt(squares / (cfg.runs - 1)) : 0.0;
+    s.meanAccuracy = accuracySum / cfg.runs;
+    s.profitProbability = static_cast<double>(profitableRuns) / cfg.runs;
+
+    sort(balances.begin(), balances.end());
+    sort(accuracies.begin(), accuracies.end());
+    s.balanceLow = percentile(balances, 0.025);
+    s.balanceMedian = percentile(balances, 0.5);
+    s.balanceHigh = percentile(balances, 0.975);
+    s.accuracyLow = percentile(accuracies, 0.025);
+    s.accuracyHigh = percentile(accuracies, 0.975);
+    return s;
+}
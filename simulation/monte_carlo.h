@@ -0,0 +1,66 @@
+#ifndef MONTE_CARLO_H
+#define MONTE_CARLO_H
+
+// Includes standard C++ libraries and project-specific headers
+#include <bits/stdc++.h>
+#include "sweep.h"
+
+using namespace std;
+
+// === Monte Carlo robustness runs ===
+
+// How each resampled news timeline is built from newsData
+struct MonteCarloConfig
+{
+    size_t runs = 1000;             // Resampled timelines per candidate
+    size_t blockSize = 64;          // Circular block bootstrap block length in events (0 = keep the history)
+    int64_t jitterSeconds = 0;      // Each event moves by up to +/- this many seconds
+    double dropProbability = 0.0;   // Chance of removing each event
+    uint64_t seed = 1;              // Base seed; every run derives its own stream from it
+};
+
+// Distribution of outcomes over all runs of one candidate.
+// Low/high bounds are the 2.5th and 97.5th percentiles (a 95% interval).
+struct MonteCarloSummary
+{
+    GridPoint params;               // Strategy parameters used
+    size_t runs = 0;
+    double meanBalance = 0.0;
+    double stdBalance = 0.0;
+    double balanceLow = 0.0;
+    double balanceMedian = 0.0;
+    double balanceHigh = 0.0;
+    double meanAccuracy = 0.0;      // Profitable sells per buy, in percent
+    double accuracyLow = 0.0;
+    double accuracyHigh = 0.0;
+    double profitProbability = 0.0; // Share of runs ending above the starting $10000
+};
+
+// A resampled event path: the drivable event source of runStrategy().
+// A worker keeps one and rebuilds it in place for every run.
+struct MonteCarloPath
+{
+    // One event of the path
+    struct Event
+    {
+        int64_t time;               // Time on the resampled timeline
+        uint32_t slot;              // Position before jitter sorting (tie-break)
+        size_t index;               // Source event in newsData
+        uint64_t entry;             // Entry price record
+        uint64_t exit;              // Forced-sell price record
+    };
+    vector<Event> events;
+
+    size_t size() const { return events.size(); }
+    const NewsEntry& news(size_t j) const { return newsData[events[j].index]; }
+    int64_t time(size_t j) const { return events[j].time; }
+    uint64_t entryRecord(size_t j) const { return events[j].entry; }
+    uint64_t exitRecord(size_t j) const { return events[j].exit; }
+};
+
+// Simulates one candidate on cfg.runs resampled timelines using `threads`
+// workers. Results depend only on the config and seed, not on the thread count.
+MonteCarloSummary runMonteCarlo(const GridPoint& params, const PriceLookupIndex& lookup,
+                                const MonteCarloConfig& cfg, unsigned threads);
+
+#endif // MONTE_CARLO_H
@@ -0,0 +1,317 @@
+// Includes standard C++ libraries and project-specific headers
+#include "parameter_search.h"
+#include "market_data.h"
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// === ParamRange ===
+
+// Every value on the grid (just min when the range is continuous)
+vector<double> ParamRange::values() const
+{
+    if (step <= 0 || max <= min) return {min};
+
+    // Index-based so rounding never drops the last value
+    size_t count = static_cast<size_t>(floor((max - min) / step + 1e-9)) + 1;
+    vector<double> out;
+    for (size_t k = 0; k < count; ++k) out.push_back(min + k * step);
+    return out;
+}
+
+// Maps u in [0, 1) onto the range, snapped to the step
+double ParamRange::sample(double u) const
+{
+    double v = min + u * (max - min);
+    if (step > 0)
+    {
+        v = min + round((v - min) / step) * step;
+        v = std::min(v, max);
+    }
+    return v;
+}
+
+// === Configuration ===
+
+// Parses "min:max[:step]" or a single fixed value
+static ParamRange parseRange(const string& key, const string& value)
+{
+    ParamRange r;
+    vector<double> parts;
+    stringstream ss(value);
+    string part;
+    while (getline(ss, part, ':')) parts.push_back(stod(part));
+
+    if (parts.size() == 1) r = {parts[0], parts[0], 0.0};
+    else if (parts.size() == 2) r = {parts[0], parts[1], 0.0};
+    else if (parts.size() == 3) r = {parts[0], parts[1], parts[2]};
+    else throw runtime_error("Invalid range for " + key + ": " + value);
+
+    if (r.max < r.min || r.step < 0)
+    {
+        throw runtime_error("Invalid range for " + key + ": " + value);
+    }
+    return r;
+}
+
+// Loads search settings from a file
+SearchConfig loadSearchConfig(const string& filename)
+{
+    SearchConfig cfg;
+
+    ifstream file(filename);
+    if (!file.is_open())
+    {
+        throw runtime_error("Failed to open search config file: " + filename);
+    }
+
+    // Strips surrounding whitespace
+    auto trim = [](string s)
+    {
+        size_t b = s.find_first_not_of(" \t\r");
+        size_t e = s.find_last_not_of(" \t\r");
+        return b == string::npos ? string() : s.substr(b, e - b + 1);
+    };
+
+    string line;
+    while (getline(file, line))
+    {
+        // Drop comments and skip lines without a key=value pair
+        line = trim(line.substr(0, line.find('#')));
+        size_t delimiterPos = line.find('=');
+        if (delimiterPos == string::npos) continue;
+
+        string key = trim(line.substr(0, delimiterPos));
+        string value = trim(line.substr(delimiterPos + 1));
+
+        try
+        {
+            if (key == "method") cfg.method = value;
+            else if (key == "investPercent") cfg.invest = parseRange(key, value);
+            else if (key == "buyThreshold") cfg.buy = parseRange(key, value);
+            else if (key == "sellThreshold") cfg.sell = parseRange(key, value);
+            else if (key == "similarityThreshold") cfg.sim = parseRange(key, value);
+            else if (key == "holdSeconds") cfg.hold = parseRange(key, value);
+            else if (key == "samples") cfg.samples = stoul(value);
+            else if (key == "maxEvaluations") cfg.maxEvaluations = stoul(value);
+            else if (key == "maxSeconds") cfg.maxSeconds = stod(value);
+            else if (key == "seed") cfg.seed = stoull(value);
+            else if (key == "eta") cfg.eta = stoi(value);
+            else if (key == "minFraction") cfg.minFraction = stod(value);
+            else if (key == "objective") cfg.objective = value;
+            else throw runtime_error("Unknown search config key: " + key);
+        }
+        catch (const invalid_argument&)
+        {
+            throw runtime_error("Invalid value for " + key + ": " + value);
+        }
+    }
+
+    static const set<string> methods = {"grid", "random", "lhs", "halving", "hyperband"};
+    if (!methods.count(cfg.method))
+    {
+        throw runtime_error("Unknown search method: " + cfg.method);
+    }
+    if (cfg.objective != "balance" && cfg.objective != "expected" && cfg.objective != "sharpe")
+    {
+        throw runtime_error("Unknown search objective: " + cfg.objective);
+    }
+    if (cfg.eta < 2 || cfg.minFraction <= 0 || cfg.minFraction > 1)
+    {
+        throw runtime_error("eta must be >= 2 and minFraction in (0, 1]");
+    }
+
+    // Every distinct hold duration gets its own exit column in the price lookup,
+    // so a continuous range would build one per sample
+    if (cfg.hold.max > cfg.hold.min && cfg.hold.step < 1)
+    {
+        throw runtime_error("holdSeconds needs a step of at least 1 second (min:max:step)");
+    }
+    return cfg;
+}
+
+// === Candidate generation ===
+
+// Builds a candidate from unit-cube coordinates
+static GridPoint pointAt(const SearchConfig& cfg, const array<double, 5>& u)
+{
+    return {cfg.invest.sample(u[0]), cfg.buy.sample(u[1]), cfg.sell.sample(u[2]),
+            cfg.sim.sample(u[3]), static_cast<int>(llround(cfg.hold.sample(u[4])))};
+}
+
+// Full cartesian grid; hold duration varies slowest so batches share it
+static vector<GridPoint> gridCandidates(const SearchConfig& cfg)
+{
+    vector<GridPoint> out;
+    for (double hold : cfg.hold.values())
+        for (double invest : cfg.invest.values())
+            for (double buyT : cfg.buy.values())
+                for (double sellT : cfg.sell.values())
+                    for (double simT : cfg.sim.values())
+                        out.push_back({invest, buyT, sellT, simT, static_cast<int>(llround(hold))});
+    return out;
+}
+
+// Independent uniform samples
+static vector<GridPoint> randomCandidates(const SearchConfig& cfg, size_t n, mt19937_64& rng)
+{
+    uniform_real_distribution<double> unit(0.0, 1.0);
+    vector<GridPoint> out;
+    for (size_t i = 0; i < n; ++i)
+    {
+        out.push_back(pointAt(cfg, {unit(rng), unit(rng), unit(rng), unit(rng), unit(rng)}));
+    }
+    return out;
+}
+
+// Latin hypercube: every dimension is cut into n strata and each stratum is
+// used by exactly one sample
+static vector<GridPoint> latinHypercubeCandidates(const SearchConfig& cfg, size_t n, mt19937_64& rng)
+{
+    uniform_real_distribution<double> unit(0.0, 1.0);
+    vector<array<double, 5>> coords(n);
+    vector<size_t> strata(n);
+    for (size_t d = 0; d < 5; ++d)
+    {
+        iota(strata.begin(), strata.end(), 0);
+        shuffle(strata.begin(), strata.end(), rng);
+        for (size_t i = 0; i < n; ++i)
+        {
+            coords[i][d] = (strata[i] + unit(rng)) / n;
+        }
+    }
+
+    vector<GridPoint> out;
+    for (auto const& u : coords) out.push_back(pointAt(cfg, u));
+    return out;
+}
+
+// Random or Latin-hypercube samples for the halving rungs
+static vector<GridPoint> sampleCandidates(const SearchConfig& cfg, size_t n, mt19937_64& rng)
+{
+    return cfg.method == "lhs" ? latinHypercubeCandidates(cfg, n, rng) : randomCandidates(cfg, n, rng);
+}
+
+// === Search engine ===
+
+// The configured objective (higher is better)
+ResultObjective objectiveOf(const SearchConfig& cfg)
+{
+    if (cfg.objective == "expected") return expectedReturnObjective;
+    if (cfg.objective == "sharpe") return sharpeObjective;
+    return balanceObjective;
+}
+
+// Evaluates the candidates `ids` on part of the timeline. Candidates are grouped
+// by hold duration so the batched kernel can share passes; each result's index
+// is the candidate's ID.
+static vector<SweepResult> evaluateCandidates(const vector<GridPoint>& candidates, vector<size_t> ids,
+                                              const PriceLookupIndex& lookup, SweepOptions options)
+{
+    stable_sort(ids.begin(), ids.end(),
+        [&](size_t a, size_t b){ return candidates[a].holdSecs < candidates[b].holdSecs; });
+
+    vector<GridPoint> grid;
+    for (size_t id : ids) grid.push_back(candidates[id]);
+
+    vector<SweepResult> results = runSweep(grid, lookup, options);
+    for (auto& r : results) r.index = ids[r.index];
+    return results;
+}
+
+// Successive halving over `ids`: evaluate everyone on a short prefix of the
+// timeline, keep the best 1/eta, and repeat on eta-times longer prefixes until
+// the survivors run on the full timeline. Returns the full-timeline results.
+static vector<SweepResult> successiveHalving(const SearchConfig& cfg, const vector<GridPoint>& candidates,
+                                             vector<size_t> ids, int rungs,
+                                             const PriceLookupIndex& lookup, SweepOptions options)
+{
+    for (int rung = rungs; rung >= 0 && !ids.empty(); --rung)
+    {
+        // Share of the timeline for this rung: eta^-rung
+        double fraction = pow(static_cast<double>(cfg.eta), -rung);
+        options.events = {0, static_cast<size_t>(ceil(fraction * newsData.size()))};
+
+        vector<SweepResult> results = evaluateCandidates(candidates, ids, lookup, options);
+        cout << "  rung " << rungs - rung << ": " << results.size() << " of " << ids.size()
+             << " candidates on " << fraction * 100 << "% of the timeline" << endl;
+        if (rung == 0) return results;
+
+        // Promote the top 1/eta (at least one) to the next rung
+        TopResults promoted(max<size_t>(1, ids.size() / cfg.eta), objectiveOf(cfg));
+        for (auto const& r : results) promoted.offer(r);
+        ids.clear();
+        for (auto const& r : promoted.sorted()) ids.push_back(r.index);
+    }
+    return {};
+}
+
+// Runs the configured search over the loaded dataset within its budget
+SearchOutcome runSearch(const SearchConfig& cfg, unsigned threads, size_t batchSize)
+{
+    SweepBudget budget(cfg.maxEvaluations, cfg.maxSeconds);
+    SweepOptions options;
+    options.threads = threads;
+    options.batchSize = batchSize;
+    options.budget = &budget;
+
+    mt19937_64 rng(cfg.seed);
+    int maxRung = static_cast<int>(floor(log(1.0 / cfg.minFraction) / log(cfg.eta) + 1e-9));
+
+    // Every candidate is drawn up front so one lookup index covers all hold durations
+    vector<GridPoint> candidates;
+    vector<pair<vector<size_t>, int>> brackets;     // Candidate IDs and rung count per bracket
+    if (cfg.method == "grid")
+    {
+        candidates = gridCandidates(cfg);
+    }
+    else if (cfg.method == "random" || cfg.method == "lhs")
+    {
+        candidates = sampleCandidates(cfg, cfg.samples, rng);
+    }
+    else
+    {
+        // halving: one bracket of `samples` candidates starting at the shortest
+        // prefix. hyperband: brackets trading candidate count against prefix
+        // length, from many short evaluations down to a plain full-timeline sample.
+        for (int s = maxRung; s >= 0; --s)
+        {
+            size_t n = cfg.method == "halving"
+                ? cfg.samples
+                : static_cast<size_t>(ceil((maxRung + 1.0) / (s + 1.0) * pow(cfg.eta, s)));
+            vector<GridPoint> drawn = randomCandidates(cfg, n, rng);
+            vector<size_t> ids(n);
+            iota(ids.begin(), ids.end(), candidates.size());
+            candidates.insert(candidates.end(), drawn.begin(), drawn.end());
+            brackets.push_back({ids, s});
+            if (cfg.method == "halving") break;
+        }
+    }
+
+    PriceLookupIndex lookup;
+    lookup.build(holdDurationsOf(candidates));
+
+    SearchOutcome outcome;
+    if (brackets.empty())
+    {
+        vector<size_t> ids(candidates.size());
+        iota(ids.begin(), ids.end(), 0);
+        outcome.results = evaluateCandidates(candidates, ids, lookup, options);
+    }
+    else
+    {
+        for (size_t b = 0; b < brackets.size() && !budget.exhausted(); ++b)
+        {
+            cout << "Bracket " << b << ": " << brackets[b].first.size() << " candidates" << endl;
+            vector<SweepResult> results = successiveHalving(cfg, candidates, brackets[b].first,
+                                                            brackets[b].second, lookup, options);
+            outcome.results.insert(outcome.results.end(), results.begin(), results.end());
+        }
+        sort(outcome.results.begin(), outcome.results.end(),
+             [](auto const& a, auto const& b){ return a.index < b.index; });
+    }
+
+    outcome.evaluations = budget.used();
+    outcome.seconds = budget.elapsedSeconds();
+    return outcome;
+}
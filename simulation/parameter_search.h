@@ -0,0 +1,85 @@
+#ifndef PARAMETER_SEARCH_H
+#define PARAMETER_SEARCH_H
+
+// Includes standard C++ libraries and project-specific headers
+#include <bits/stdc++.h>
+#include "sweep.h"
+#include "result_collector.h"
+
+using namespace std;
+
+// === Parameter search configuration ===
+
+// Range of one strategy parameter. A positive step restricts values to
+// min + k * step (the grid resolution); a step of 0 leaves the range continuous.
+struct ParamRange
+{
+    double min = 0.0;
+    double max = 0.0;
+    double step = 0.0;
+
+    // Every value on the grid (just min when the range is continuous)
+    vector<double> values() const;
+
+    // Maps u in [0, 1) onto the range, snapped to the step
+    double sample(double u) const;
+};
+
+// Search settings, read from a key=value file such as:
+//
+//   method=hyperband              grid | random | lhs | halving | hyperband
+//   investPercent=0.005:0.05:0.005
+//   buyThreshold=0.8:0.9:0.05
+//   sellThreshold=-0.5:-0.1:0.1
+//   similarityThreshold=0.5:0.65:0.05
+//   holdSeconds=3600:172800:3600
+//   samples=500                   candidates for random, lhs and halving
+//   maxEvaluations=0              0 = unlimited
+//   maxSeconds=600                0 = unlimited
+//   seed=1
+//   eta=3                         halving/hyperband reduction factor
+//   minFraction=0.037             smallest share of the news timeline a
+//                                 halving/hyperband rung is evaluated on
+//   objective=balance             balance | expected | sharpe
+//
+// The defaults span the ranges of the built-in sweep, but ranges here always
+// include their end points (the built-in float loops drop some of them).
+// A holdSeconds range must have a step: each distinct duration costs a
+// column of exit prices.
+struct SearchConfig
+{
+    string method = "grid";
+    ParamRange invest{0.005, 0.05, 0.005};
+    ParamRange buy{0.8, 0.9, 0.05};
+    ParamRange sell{-0.5, -0.1, 0.1};
+    ParamRange sim{0.5, 0.65, 0.05};
+    ParamRange hold{86400, 86400, 0};
+    size_t samples = 100;
+    size_t maxEvaluations = 0;
+    double maxSeconds = 0.0;
+    uint64_t seed = 1;
+    int eta = 3;
+    double minFraction = 1.0 / 27.0;
+    string objective = "balance";
+};
+
+// Loads search settings from a file; throws runtime_error on unknown keys or bad values
+SearchConfig loadSearchConfig(const string& filename);
+
+// === Search engine ===
+
+// Outcome of a search run
+struct SearchOutcome
+{
+    vector<SweepResult> results;    // Full-timeline evaluations, index = candidate number
+    size_t evaluations = 0;         // Evaluations run, including partial-timeline rungs
+    double seconds = 0.0;           // Wall-clock time spent
+};
+
+// The configured objective (higher is better)
+ResultObjective objectiveOf(const SearchConfig& cfg);
+
+// Runs the configured search over the loaded dataset within its budget
+SearchOutcome runSearch(const SearchConfig& cfg, unsigned threads, size_t batchSize);
+
+#endif // PARAMETER_SEARCH_H
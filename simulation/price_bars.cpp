@@ -0,0 +1,153 @@
+// Includes standard C++ libraries and project-specific headers
+#include "price_bars.h"
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// Start of the bucket of length `seconds` holding time t (rounds down, also before 1970)
+static int64_t bucketStart(int64_t t, int64_t seconds)
+{
+    int64_t r = t % seconds;
+    return t - (r < 0 ? r + seconds : r);
+}
+
+// === PriceBarCache ===
+
+// Builds one level per resolution, finest first
+void PriceBarCache::build(const vector<int64_t>& resolutions)
+{
+    barLevels.clear();
+    size_t tickers = priceData.tickerCount();
+
+    for (int64_t seconds : resolutions)
+    {
+        BarLevel level;
+        level.seconds = seconds;
+        level.tickerBegin.assign(tickers + 1, 0);
+        bool fromRecords = barLevels.empty();
+        const BarLevel* below = fromRecords ? nullptr : &barLevels.back();
+        level.childCount = fromRecords ? priceData.recordCount() : below->bars.size();
+        if (!fromRecords && seconds % below->seconds != 0)
+        {
+            throw invalid_argument("Bar resolution " + to_string(seconds) + "s is not a multiple of " +
+                                   to_string(below->seconds) + "s");
+        }
+
+        for (TickerId id = 0; id < tickers; ++id)
+        {
+            level.tickerBegin[id] = level.bars.size();
+
+            // Children of this ticker: its records, or its bars one level finer
+            uint64_t begin, end;
+            if (fromRecords)
+            {
+                begin = priceData.recordOffset(id);
+                end = begin + priceData.series(id).size;
+            }
+            else
+            {
+                begin = below->tickerBegin[id];
+                end = below->tickerBegin[id + 1];
+            }
+
+            for (uint64_t c = begin; c < end; ++c)
+            {
+                int64_t t;
+                double open, high, low, close;
+                if (fromRecords)
+                {
+                    t = priceData.recordTime(c);
+                    open = high = low = close = priceData.recordPrice(c);
+                }
+                else
+                {
+                    const PriceBar& b = below->bars[c];
+                    t = b.start;
+                    open = b.open;
+                    high = b.high;
+                    low = b.low;
+                    close = b.close;
+                }
+
+                int64_t start = bucketStart(t, seconds);
+                if (level.bars.size() == level.tickerBegin[id] || level.bars.back().start != start)
+                {
+                    level.bars.push_back({start, open, high, low, close, c});
+                }
+                else
+                {
+                    PriceBar& bar = level.bars.back();
+                    bar.high = max(bar.high, high);
+                    bar.low = min(bar.low, low);
+                    bar.close = close;
+                }
+            }
+        }
+        level.tickerBegin[tickers] = level.bars.size();
+
+        // A level that merges nothing only adds a step to every query
+        if (level.bars.size() == level.childCount) continue;
+        barLevels.push_back(move(level));
+    }
+}
+
+// First record of a ticker in [from, to) at or beyond either level
+uint64_t PriceBarCache::firstCross(TickerId id, int64_t from, int64_t to, double low, double high) const
+{
+    if (from >= to || id >= priceData.tickerCount()) return PriceLookupIndex::NO_PRICE;
+
+    // Coarsest level whose bars fit in the window
+    size_t L = barLevels.size();
+    while (L > 0 && barLevels[L - 1].seconds > to - from) --L;
+    if (L == 0)
+    {
+        PriceSeries s = priceData.series(id);
+        uint64_t offset = priceData.recordOffset(id);
+        return scanRecords(offset + s.lowerBound(from), offset + s.size, from, to, low, high);
+    }
+
+    // First bar of the ticker that ends after `from`
+    const BarLevel& level = barLevels[--L];
+    auto first = level.bars.begin() + level.tickerBegin[id];
+    auto last = level.bars.begin() + level.tickerBegin[id + 1];
+    auto it = lower_bound(first, last, from - level.seconds + 1,
+        [](const PriceBar& b, int64_t t){ return b.start < t; });
+    return scanLevel(L, it - level.bars.begin(), last - level.bars.begin(), from, to, low, high);
+}
+
+// Searches bars [begin, end) of level L, descending into possible crossings
+uint64_t PriceBarCache::scanLevel(size_t L, uint64_t begin, uint64_t end, int64_t from, int64_t to,
+                                  double low, double high) const
+{
+    const BarLevel& level = barLevels[L];
+    for (uint64_t i = begin; i < end; ++i)
+    {
+        const PriceBar& bar = level.bars[i];
+        if (bar.start >= to) break;
+
+        // Nothing inside the bar reaches either level
+        if (bar.low > low && bar.high < high) continue;
+
+        uint64_t childEnd = i + 1 < level.bars.size() ? level.bars[i + 1].first : level.childCount;
+        uint64_t found = L == 0
+            ? scanRecords(bar.first, childEnd, from, to, low, high)
+            : scanLevel(L - 1, bar.first, childEnd, from, to, low, high);
+        if (found != PriceLookupIndex::NO_PRICE) return found;
+    }
+    return PriceLookupIndex::NO_PRICE;
+}
+
+// Searches price records [begin, end)
+uint64_t PriceBarCache::scanRecords(uint64_t begin, uint64_t end, int64_t from, int64_t to,
+                                    double low, double high) const
+{
+    for (uint64_t r = begin; r < end; ++r)
+    {
+        int64_t t = priceData.recordTime(r);
+        if (t < from) continue;
+        if (t >= to) break;
+        double price = priceData.recordPrice(r);
+        if (price <= low || price >= high) return r;
+    }
+    return PriceLookupIndex::NO_PRICE;
+}
@@ -0,0 +1,214 @@
+#ifndef PRICE_BARS_H
+#define PRICE_BARS_H
+
+// Includes standard C++ libraries and project-specific headers
+#include <bits/stdc++.h>
+#include "backtest.h"
+
+using namespace std;
+
+// === Multi-resolution price bars ===
+
+// OHLC summary of one ticker's records in one time bucket
+struct PriceBar
+{
+    int64_t start;              // Bucket start (a multiple of the level's length, UTC)
+    double open, high, low, close;
+    uint64_t first;             // First child: bar index one level finer, or
+                                // global price record for the finest level
+};
+
+// Bars of every ticker at one resolution, stored like PriceStore: the bars of
+// ticker id are [tickerBegin[id], tickerBegin[id + 1])
+struct BarLevel
+{
+    int64_t seconds;            // Bucket length
+    vector<PriceBar> bars;
+    vector<uint64_t> tickerBegin;
+    uint64_t childCount;        // Children in total (bars one level finer, or price records)
+};
+
+// A hierarchy of OHLC bars over priceData, built once after loading. Each
+// bar's children are the finer bars (or, at the finest level, the raw price
+// records) inside it, so a query descends without searching.
+class PriceBarCache
+{
+public:
+    // Builds one level per resolution (seconds, each a multiple of the previous).
+    // Levels that would not merge any records or bars of the level below, such
+    // as 1s bars over per-minute prices, are left out.
+    void build(const vector<int64_t>& resolutions = {1, 60, 300, 3600, 86400});
+
+    // First price record of a ticker with time in [from, to) and a price at or
+    // below `low` or at or above `high` (PriceLookupIndex::NO_PRICE if none).
+    // Starts at the coarsest level with bars no longer than the window, skips
+    // every bar whose range stays strictly between both levels, and only
+    // descends into the rest, so the answer is exact.
+    uint64_t firstCross(TickerId id, int64_t from, int64_t to, double low, double high) const;
+
+    // Levels from finest to coarsest
+    const vector<BarLevel>& levels() const { return barLevels; }
+
+private:
+    // Searches bars [begin, end) of level L, descending into possible crossings
+    uint64_t scanLevel(size_t L, uint64_t begin, uint64_t end, int64_t from, int64_t to,
+                       double low, double high) const;
+
+    // Searches price records [begin, end)
+    uint64_t scanRecords(uint64_t begin, uint64_t end, int64_t from, int64_t to,
+                         double low, double high) const;
+
+    vector<BarLevel> barLevels;
+};
+
+// === Bar exit kernel ===
+
+// Scheduled close of one position, ordered like the ticks of MarketTimeline
+struct BarExit
+{
+    int64_t time;               // Time of the closing price record
+    TickerId tickerId;          // Ticker holding the position
+    uint64_t seq;               // Position the exit belongs to
+
+    // Min-heap ordering: earliest first, then ticker, then buy order
+    bool operator>(const BarExit& other) const
+    {
+        if (time != other.time) return time > other.time;
+        if (tickerId != other.tickerId) return tickerId > other.tickerId;
+        return seq > other.seq;
+    }
+};
+
+// Per-run state of the bar exit kernel. Each worker owns one and reuses it.
+struct BarState
+{
+    vector<PositionQueue> positions;    // Open positions by ticker, in buy order
+    vector<BarExit> exits;              // Min-heap of scheduled closes
+    uint64_t nextSeq = 0;               // Sequence number for the next opened position
+
+    // Drops all open positions before the next run (one slot per known ticker)
+    void reset()
+    {
+        positions.resize(priceData.tickerCount());
+        for (auto& q : positions) q.clear();
+        exits.clear();
+        nextSeq = 0;
+    }
+};
+
+// Runs one strategy with stop-loss / take-profit exits (Exit::stopPrice and
+// Exit::targetPrice) over the news only. When a position opens, its closing
+// record is resolved up front: the first tick after the buy that crosses a
+// level (found through the bar cache) or else the first tick at or after its
+// expiry. Closes are applied in time order between news events, exactly as
+// simulateTimeline() applies them while walking every tick, so both kernels
+// give the same results. The hold duration must be covered by the lookup index.
+template<typename Strategy>
+double simulateBars(const Strategy& strategy,
+                    const PriceLookupIndex& lookup,
+                    const PriceBarCache& bars,
+                    BarState& state,
+                    int& totalTrades,
+                    int& profitableTrades,
+                    TradeStats& tradeStats,
+                    EventRange range = {})
+{
+    const uint64_t* expiryRecords = lookup.exitsFor(strategy.exit.holdSeconds);
+    if (!expiryRecords)
+    {
+        throw invalid_argument("Hold duration " + to_string(strategy.exit.holdSeconds) + "s is not in the price lookup index");
+    }
+
+    double balance = 10000.0;       // Starting cash balance
+    state.reset();
+    totalTrades = profitableTrades = 0;
+    tradeStats.reset();
+    auto& exits = state.exits;
+
+    // Closes one position at its resolved record
+    auto close = [&](const InvestmentNode& node)
+    {
+        double price = priceData.recordPrice(node.exitRecord);
+        double pnl = node.quantity * (price - node.buyPrice);
+        if (pnl > 0) ++profitableTrades;
+        tradeStats.add(pnl);
+        balance += node.quantity * price;
+    };
+
+    size_t end = min(range.end, newsData.size());
+    for (size_t i = min(range.begin, end); i < end; ++i)
+    {
+        auto const& news = newsData[i];
+        int64_t now = news.timestamp;
+
+        // --- Scheduled closes strictly before this news (ticks at `now` follow it) ---
+        while (!exits.empty() && exits.front().time < now)
+        {
+            BarExit due = exits.front();
+            pop_heap(exits.begin(), exits.end(), greater<BarExit>());
+            exits.pop_back();
+
+            // Usually the oldest position; a stop can also hit a newer one.
+            // Positions closed by a sell signal are no longer there.
+            auto& q = state.positions[due.tickerId];
+            if (!q.empty() && q.front().seq == due.seq)
+            {
+                close(q.front());
+                q.pop_front();
+                continue;
+            }
+            for (size_t k = q.head; k < q.nodes.size(); ++k)
+            {
+                if (q.nodes[k].seq != due.seq) continue;
+                close(q.nodes[k]);
+                q.nodes.erase(q.nodes.begin() + k);
+                break;
+            }
+        }
+
+        StrategyAction action = strategy.decide(news.similarity, news.sentiment);
+        if (action == StrategyAction::Ignore) continue;
+
+        uint64_t entryRecord = lookup.entry[i];
+        if (entryRecord == PriceLookupIndex::NO_PRICE) continue;
+        double currentPrice = priceData.recordPrice(entryRecord);
+        auto& q = state.positions[news.tickerId];
+
+        // --- SELL: negative sentiment closes all positions for the ticker ---
+        if (action == StrategyAction::Sell)
+        {
+            for (size_t k = q.head; k < q.nodes.size(); ++k)
+            {
+                double pnl = q.nodes[k].quantity * (currentPrice - q.nodes[k].buyPrice);
+                if (pnl > 0) ++profitableTrades;
+                tradeStats.add(pnl);
+                balance += q.nodes[k].quantity * currentPrice;
+            }
+            q.clear();
+        }
+        // --- BUY: open a position and resolve where it will close ---
+        else if (action == StrategyAction::Buy)
+        {
+            double toInvest = strategy.positionCash(balance);
+            balance -= toInvest;
+            ++totalTrades;
+
+            uint64_t exitRecord = bars.firstCross(news.tickerId, now, strategy.expiry(now),
+                                                  strategy.exit.stopPrice(currentPrice),
+                                                  strategy.exit.targetPrice(currentPrice));
+            if (exitRecord == PriceLookupIndex::NO_PRICE) exitRecord = expiryRecords[i];
+
+            uint64_t seq = state.nextSeq++;
+            q.push_back({seq, toInvest / currentPrice, currentPrice, now, exitRecord});
+            if (exitRecord != PriceLookupIndex::NO_PRICE)
+            {
+                exits.push_back({priceData.recordTime(exitRecord), news.tickerId, seq});
+                push_heap(exits.begin(), exits.end(), greater<BarExit>());
+            }
+        }
+    }
+
+    return balance;
+}
+
+#endif // PRICE_BARS_H
@@ -0,0 +1,271 @@
+// Includes standard C++ libraries and project-specific headers
+#include "result_collector.h"
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// Identifies a binary result file
+static const char RESULT_MAGIC[8] = {'N', 'D', 'T', 'S', 'W', 'E', 'E', 'P'};
+
+// The buffer is handed to the file once it grows past this many bytes
+static constexpr size_t WRITE_BUFFER_BYTES = 1 << 20;
+
+// === Objectives ===
+
+// Final cash balance of a run
+double balanceObjective(const SweepResult& r)
+{
+    return r.result;
+}
+
+// profitable * median win + losing * median loss of a run
+double expectedReturnObjective(const SweepResult& r)
+{
+    return r.expectedReturn;
+}
+
+// Mean trade P&L per unit of trade volatility of a run
+double sharpeObjective(const SweepResult& r)
+{
+    return r.sharpe;
+}
+
+// === TopResults ===
+
+TopResults::TopResults(size_t k, ResultObjective objective)
+    : k(k), objective(objective)
+{
+}
+
+// True if a ranks above b
+bool TopResults::better(const SweepResult& a, const SweepResult& b) const
+{
+    double sa = objective(a), sb = objective(b);
+    return sa != sb ? sa > sb : a.index < b.index;
+}
+
+// Considers one result for the top k
+void TopResults::offer(const SweepResult& r)
+{
+    if (k == 0) return;
+
+    // Min-heap under better(): the front is the worst result kept
+    auto cmp = [this](const SweepResult& a, const SweepResult& b){ return better(a, b); };
+    if (heap.size() < k)
+    {
+        heap.push_back(r);
+        push_heap(heap.begin(), heap.end(), cmp);
+    }
+    else if (better(r, heap.front()))
+    {
+        pop_heap(heap.begin(), heap.end(), cmp);
+        heap.back() = r;
+        push_heap(heap.begin(), heap.end(), cmp);
+    }
+}
+
+// Kept results, best first
+vector<SweepResult> TopResults::sorted() const
+{
+    vector<SweepResult> out = heap;
+    sort(out.begin(), out.end(), [this](auto const& a, auto const& b){ return better(a, b); });
+    return out;
+}
+
+// === ResultWriter ===
+
+ResultWriter::~ResultWriter()
+{
+    close();
+}
+
+// Creates the file; returns false if it cannot be opened
+bool ResultWriter::open(const string& path)
+{
+    close();
+    this->path = path;
+    failed = false;
+    file = fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        cerr << "Failed to open results file for writing: " << path << endl;
+        return false;
+    }
+
+    binary = path.size() >= 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+    buffer.reserve(WRITE_BUFFER_BYTES + 4096);
+    if (binary)
+    {
+        ResultFileHeader header{};
+        memcpy(header.magic, RESULT_MAGIC, sizeof(header.magic));
+        header.version = 2;
+        header.recordSize = sizeof(ResultRecord);
+        buffer.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    else
+    {
+        buffer += "index,invest,buyT,sellT,simT,holdSecs,result,trades,profitable,"
+                  "bestWin,bestLoss,medWin,medLoss,expectedReturn,volatility,sharpe,maxDrawdown\n";
+    }
+    return true;
+}
+
+// Appends one result
+void ResultWriter::write(const SweepResult& r)
+{
+    if (!file) return;
+
+    if (binary)
+    {
+        ResultRecord rec{};
+        rec.index = r.index;
+        rec.invest = r.params.invest;
+        rec.buyT = r.params.buyT;
+        rec.sellT = r.params.sellT;
+        rec.simT = r.params.simT;
+        rec.holdSecs = r.params.holdSecs;
+        rec.trades = r.trades;
+        rec.profitable = r.profitable;
+        rec.result = r.result;
+        rec.bestWin = r.bestWin;
+        rec.bestLoss = r.bestLoss;
+        rec.medWin = r.medWin;
+        rec.medLoss = r.medLoss;
+        rec.expectedReturn = r.expectedReturn;
+        rec.volatility = r.volatility;
+        rec.sharpe = r.sharpe;
+        rec.maxDrawdown = r.maxDrawdown;
+        buffer.append(reinterpret_cast<const char*>(&rec), sizeof(rec));
+    }
+    else
+    {
+        // Shortest round-trip formatting keeps the file compact and exact
+        char line[512];
+        char* p = line;
+        char* end = line + sizeof(line) - 1;     // Leaves room for the separator
+        auto field = [&](auto value, char sep)
+        {
+            p = to_chars(p, end, value).ptr;
+            *p++ = sep;
+        };
+        field(r.index, ',');
+        field(r.params.invest, ',');
+        field(r.params.buyT, ',');
+        field(r.params.sellT, ',');
+        field(r.params.simT, ',');
+        field(r.params.holdSecs, ',');
+        field(r.result, ',');
+        field(r.trades, ',');
+        field(r.profitable, ',');
+        field(r.bestWin, ',');
+        field(r.bestLoss, ',');
+        field(r.medWin, ',');
+        field(r.medLoss, ',');
+        field(r.expectedReturn, ',');
+        field(r.volatility, ',');
+        field(r.sharpe, ',');
+        field(r.maxDrawdown, '\n');
+        buffer.append(line, p - line);
+    }
+
+    if (buffer.size() >= WRITE_BUFFER_BYTES) flush();
+}
+
+// Hands the buffered bytes to the file
+void ResultWriter::flush()
+{
+    if (file && !buffer.empty() && fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size())
+    {
+        failed = true;
+    }
+    buffer.clear();
+}
+
+// Flushes the buffer and closes the file; false if any write failed
+bool ResultWriter::close()
+{
+    if (!file) return true;
+    flush();
+    if (ferror(file)) failed = true;
+    if (fclose(file) != 0) failed = true;
+    file = nullptr;
+    if (failed)
+    {
+        cerr << "Failed to write results file: " << path << " (the file is incomplete)" << endl;
+    }
+    return !failed;
+}
+
+// === Reading result files ===
+
+// Reads a binary result file written by ResultWriter into a collector
+bool readResultFile(const string& path, ResultCollector& collector)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        cerr << "Failed to open results file: " << path << endl;
+        return false;
+    }
+
+    ResultFileHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        memcmp(header.magic, RESULT_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != 2 || header.recordSize != sizeof(ResultRecord))
+    {
+        cerr << "Not a version 2 binary results file: " << path << endl;
+        fclose(file);
+        return false;
+    }
+
+    // Records are handed over in blocks, like sweep workers do
+    vector<ResultRecord> records(4096);
+    vector<SweepResult> block;
+    block.reserve(records.size());
+    size_t count;
+    while ((count = fread(records.data(), sizeof(ResultRecord), records.size(), file)) > 0)
+    {
+        block.clear();
+        for (size_t i = 0; i < count; ++i)
+        {
+            const ResultRecord& rec = records[i];
+            block.push_back({rec.index, {rec.invest, rec.buyT, rec.sellT, rec.simT, rec.holdSecs},
+                             rec.result, rec.trades, rec.profitable, rec.bestWin, rec.bestLoss,
+                             rec.medWin, rec.medLoss, rec.expectedReturn, rec.volatility,
+                             rec.sharpe, rec.maxDrawdown});
+        }
+        collector.add(block);
+    }
+
+    // A partial trailing record means the writer did not finish
+    bool complete = feof(file) && !ferror(file) && ftell(file) >= 0 &&
+        (static_cast<size_t>(ftell(file)) - sizeof(header)) % sizeof(ResultRecord) == 0;
+    fclose(file);
+    if (!complete)
+    {
+        cerr << "Results file is truncated: " << path << endl;
+        return false;
+    }
+    return true;
+}
+
+// === ResultCollector ===
+
+ResultCollector::ResultCollector(size_t k, ResultWriter* writer)
+    : byBalance(k, balanceObjective), byExpected(k, expectedReturnObjective), writer(writer)
+{
+}
+
+// Records a batch of results
+void ResultCollector::add(const vector<SweepResult>& results)
+{
+    lock_guard<mutex> lock(m);
+    for (auto const& r : results)
+    {
+        ++totalRuns;
+        if (r.result > 10000.0) ++profitableRuns;
+        byBalance.offer(r);
+        byExpected.offer(r);
+        if (writer) writer->write(r);
+    }
+}
@@ -0,0 +1,131 @@
+#ifndef RESULT_COLLECTOR_H
+#define RESULT_COLLECTOR_H
+
+// Includes standard C++ libraries and project-specific headers
+#include <bits/stdc++.h>
+#include "sweep.h"
+
+using namespace std;
+
+// === Sweep result collection ===
+
+// Score used to rank results (higher is better)
+using ResultObjective = double (*)(const SweepResult&);
+
+// Final cash balance of a run
+double balanceObjective(const SweepResult& r);
+
+// profitable * median win + losing * median loss of a run
+double expectedReturnObjective(const SweepResult& r);
+
+// Mean trade P&L per unit of trade volatility of a run
+double sharpeObjective(const SweepResult& r);
+
+// Keeps the k best results seen so far in a bounded min-heap.
+// Equal scores rank the lower grid index first, so the kept set does not
+// depend on the order results arrive in.
+class TopResults
+{
+public:
+    TopResults(size_t k, ResultObjective objective);
+
+    // Considers one result for the top k
+    void offer(const SweepResult& r);
+
+    // Kept results, best first
+    vector<SweepResult> sorted() const;
+
+private:
+    // True if a ranks above b
+    bool better(const SweepResult& a, const SweepResult& b) const;
+
+    size_t k;
+    ResultObjective objective;
+    vector<SweepResult> heap;   // Worst kept result at the front
+};
+
+// Streams every result to a file through a large in-memory buffer.
+// Files ending in ".bin" get fixed-size binary records (ResultRecord after a
+// ResultFileHeader); anything else gets CSV with a header row. Rows appear in
+// the order results are written, each tagged with its grid index.
+class ResultWriter
+{
+public:
+    ~ResultWriter();
+
+    // Creates the file; returns false if it cannot be opened
+    bool open(const string& path);
+
+    // Appends one result
+    void write(const SweepResult& r);
+
+    // Flushes the buffer and closes the file. Returns false (with a message)
+    // if any write since open() failed, e.g. on a full disk; true if no file is open.
+    bool close();
+
+private:
+    // Hands the buffered bytes to the file
+    void flush();
+
+    FILE* file = nullptr;
+    string path;            // For the error message
+    bool binary = false;
+    bool failed = false;    // A write to the file failed
+    string buffer;
+};
+
+// Header of a binary result file
+struct ResultFileHeader
+{
+    char magic[8];          // "NDTSWEEP"
+    uint32_t version;       // 2 (1 had no volatility, sharpe or maxDrawdown)
+    uint32_t recordSize;    // sizeof(ResultRecord)
+};
+
+// One result in a binary result file (host byte order)
+struct ResultRecord
+{
+    uint64_t index;
+    double invest, buyT, sellT, simT;
+    int32_t holdSecs;
+    int32_t trades;
+    int32_t profitable;
+    int32_t reserved;       // Padding, always zero
+    double result, bestWin, bestLoss, medWin, medLoss, expectedReturn;
+    double volatility, sharpe, maxDrawdown;
+};
+
+class ResultCollector;
+
+// Reads a binary result file written by ResultWriter into a collector.
+// Returns false (with a message) if the file is missing, of another
+// version or truncated; results read before a truncation are kept.
+bool readResultFile(const string& path, ResultCollector& collector);
+
+// Thread-safe sink for sweep results: keeps the top k by final balance and by
+// expected return, counts runs, and optionally streams every result to a writer
+class ResultCollector
+{
+public:
+    explicit ResultCollector(size_t k, ResultWriter* writer = nullptr);
+
+    // Records a batch of results (called by sweep workers as blocks finish)
+    void add(const vector<SweepResult>& results);
+
+    // Best results by final balance and by expected return, best first
+    vector<SweepResult> topByBalance() const { return byBalance.sorted(); }
+    vector<SweepResult> topByExpectedReturn() const { return byExpected.sorted(); }
+
+    size_t total() const { return totalRuns; }
+    size_t profitable() const { return profitableRuns; }
+
+private:
+    mutable mutex m;
+    TopResults byBalance;
+    TopResults byExpected;
+    ResultWriter* writer;
+    size_t totalRuns = 0;
+    size_t profitableRuns = 0;      // Runs ending above the starting $10000
+};
+
+#endif // RESULT_COLLECTOR_H
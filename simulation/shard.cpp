@@ -0,0 +1,245 @@
+// Includes standard C++ libraries and project-specific headers
+#include "shard.h"
+#include <bits/stdc++.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#endif
+
+using namespace std;
+
+// === Shard layout ===
+
+// Parses "I/N" (shard I of N, 0-based)
+bool parseShardSpec(const string& text, ShardSpec& spec)
+{
+    size_t slash = text.find('/');
+    if (slash == string::npos) return false;
+
+    ShardSpec parsed;
+    const char* first = text.data();
+    const char* last = text.data() + text.size();
+    auto index = from_chars(first, first + slash, parsed.index);
+    auto count = from_chars(first + slash + 1, last, parsed.count);
+    if (index.ec != errc() || index.ptr != first + slash ||
+        count.ec != errc() || count.ptr != last ||
+        parsed.count == 0 || parsed.index >= parsed.count)
+    {
+        return false;
+    }
+    spec = parsed;
+    return true;
+}
+
+// Half-open grid index range of a shard; sizes differ by at most one point
+pair<size_t, size_t> shardBounds(size_t points, const ShardSpec& spec)
+{
+    return {points * spec.index / spec.count, points * (spec.index + 1) / spec.count};
+}
+
+// Result file of a shard inside the shared directory
+string shardFilePath(const string& directory, const ShardSpec& spec)
+{
+    string name = "shard-" + to_string(spec.index) + "-of-" + to_string(spec.count) + ".bin";
+    return (filesystem::path(directory) / name).string();
+}
+
+// === Merging ===
+
+// Reads every shard file of a sweep from `directory` into the collector
+bool mergeShardFiles(const string& directory, ResultCollector& collector, size_t& shards)
+{
+    error_code ec;
+    filesystem::directory_iterator it(directory, ec);
+    if (ec)
+    {
+        cerr << "Failed to read shard directory " << directory << ": " << ec.message() << endl;
+        return false;
+    }
+
+    // Shard files found, by shard count
+    map<size_t, set<size_t>> found;
+    for (auto const& entry : it)
+    {
+        string name = entry.path().filename().string();
+        ShardSpec spec;
+        size_t of = name.find("-of-");
+        if (name.rfind("shard-", 0) != 0 || of == string::npos ||
+            name.size() < 4 || name.compare(name.size() - 4, 4, ".bin") != 0)
+        {
+            continue;
+        }
+        string text = name.substr(6, of - 6) + "/" + name.substr(of + 4, name.size() - 4 - of - 4);
+        if (parseShardSpec(text, spec)) found[spec.count].insert(spec.index);
+    }
+
+    if (found.empty())
+    {
+        cerr << "No shard files in " << directory << endl;
+        return false;
+    }
+    if (found.size() > 1)
+    {
+        cerr << "Shard directory " << directory << " mixes sweeps split into";
+        for (auto const& f : found) cerr << " " << f.first;
+        cerr << " shards" << endl;
+        return false;
+    }
+
+    shards = found.begin()->first;
+    auto const& present = found.begin()->second;
+    bool ok = true;
+    for (size_t i = 0; i < shards; ++i)
+    {
+        if (!present.count(i))
+        {
+            cerr << "Missing shard " << i << "/" << shards << " in " << directory << endl;
+            ok = false;
+        }
+    }
+    if (!ok) return false;
+
+    for (size_t i = 0; i < shards; ++i)
+    {
+        if (!readResultFile(shardFilePath(directory, {i, shards}), collector)) ok = false;
+    }
+    return ok;
+}
+
+// === Local coordinator ===
+
+#ifdef _WIN32
+// Quotes one argument so the C runtime of the child parses it back unchanged
+// (backslashes only escape a following quote)
+static string quoteArgument(const string& arg)
+{
+    string quoted = "\"";
+    size_t slashes = 0;
+    for (char c : arg)
+    {
+        if (c == '\\')
+        {
+            ++slashes;
+            continue;
+        }
+        quoted.append(c == '"' ? slashes * 2 + 1 : slashes, '\\');
+        quoted += c;
+        slashes = 0;
+    }
+    quoted.append(slashes * 2, '\\');
+    return quoted + "\"";
+}
+#endif
+
+// Runs argv[0] (looked up on PATH) with argv as its arguments and its stdout and
+// stderr in `log`, without a shell, and waits for it. Returns its exit code
+// (128 + the signal if it was killed), or -1 if it could not be started.
+static int runLogged(const vector<string>& argv, const string& log)
+{
+#ifdef _WIN32
+    SECURITY_ATTRIBUTES sa{sizeof(SECURITY_ATTRIBUTES), nullptr, TRUE};
+    HANDLE output = CreateFileA(log.c_str(), GENERIC_WRITE, FILE_SHARE_READ, &sa, CREATE_ALWAYS,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (output == INVALID_HANDLE_VALUE)
+    {
+        cerr << "Failed to create shard log " << log << endl;
+        return -1;
+    }
+
+    STARTUPINFOA si{};
+    si.cb = sizeof(si);
+    si.dwFlags = STARTF_USESTDHANDLES;
+    si.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+    si.hStdOutput = output;
+    si.hStdError = output;
+    PROCESS_INFORMATION pi{};
+
+    string line;
+    for (auto const& arg : argv) line += (line.empty() ? "" : " ") + quoteArgument(arg);
+    BOOL created = CreateProcessA(nullptr, &line[0], nullptr, nullptr, TRUE, 0, nullptr, nullptr, &si, &pi);
+    CloseHandle(output);
+    if (!created)
+    {
+        cerr << "Failed to start " << argv[0] << " (error " << GetLastError() << ")" << endl;
+        return -1;
+    }
+    CloseHandle(pi.hThread);
+    WaitForSingleObject(pi.hProcess, INFINITE);
+    DWORD code = 1;
+    GetExitCodeProcess(pi.hProcess, &code);
+    CloseHandle(pi.hProcess);
+    return static_cast<int>(code);
+#else
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO);
+
+    vector<char*> args;
+    for (auto const& arg : argv) args.push_back(const_cast<char*>(arg.c_str()));
+    args.push_back(nullptr);
+    pid_t pid;
+    int error = posix_spawnp(&pid, args[0], &actions, nullptr, args.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    if (error != 0)
+    {
+        cerr << "Failed to start " << argv[0] << ": " << strerror(error) << endl;
+        return -1;
+    }
+
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+#endif
+}
+
+// Runs `shards` local copies of a command concurrently, one per shard
+bool runLocalShards(const vector<string>& command, size_t shards, const string& directory)
+{
+    error_code ec;
+    filesystem::create_directories(directory, ec);
+    if (ec)
+    {
+        cerr << "Failed to create shard directory " << directory << ": " << ec.message() << endl;
+        return false;
+    }
+
+    // Results of an earlier split would confuse the merge
+    for (auto const& entry : filesystem::directory_iterator(directory))
+    {
+        string name = entry.path().filename().string();
+        if (name.rfind("shard-", 0) == 0 && name.find("-of-") != string::npos) filesystem::remove(entry.path());
+    }
+
+    // Each shard is waited for by its own thread, so they all run at once
+    vector<int> status(shards, 0);
+    vector<thread> waiters;
+    for (size_t i = 0; i < shards; ++i)
+    {
+        ShardSpec spec{i, shards};
+        vector<string> argv = command;
+        argv.insert(argv.end(), {"--shard", to_string(i) + "/" + to_string(shards), "--shard-dir", directory});
+        string log = shardFilePath(directory, spec);
+        log.replace(log.size() - 4, 4, ".log");
+        waiters.emplace_back([&status, i, argv, log]() { status[i] = runLogged(argv, log); });
+    }
+    for (auto& t : waiters) t.join();
+
+    bool ok = true;
+    for (size_t i = 0; i < shards; ++i)
+    {
+        if (status[i] != 0)
+        {
+            cerr << "Shard " << i << "/" << shards << " failed (exit code " << status[i] << "), see its log in "
+                 << directory << endl;
+            ok = false;
+        }
+    }
+    return ok;
+}
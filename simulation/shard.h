@@ -0,0 +1,45 @@
+#ifndef SHARD_H
+#define SHARD_H
+
+// Includes standard C++ libraries and project-specific headers
+#include <bits/stdc++.h>
+#include "result_collector.h"
+
+using namespace std;
+
+// === Sharded sweeps ===
+//
+// A sweep split into `count` shards by contiguous grid index ranges. Each shard
+// can run as a separate process on any host that sees the shared directory; it
+// writes its results, tagged with their global grid indices, to
+// shard-<index>-of-<count>.bin there. The merge step reads every shard file
+// into one collector.
+
+// One shard of a sweep (0-based index)
+struct ShardSpec
+{
+    size_t index = 0;
+    size_t count = 1;
+};
+
+// Parses "I/N" (shard I of N, 0-based); returns false on bad input
+bool parseShardSpec(const string& text, ShardSpec& spec);
+
+// Half-open grid index range [first, second) of a shard of `points` grid points
+pair<size_t, size_t> shardBounds(size_t points, const ShardSpec& spec);
+
+// Result file of a shard inside the shared directory
+string shardFilePath(const string& directory, const ShardSpec& spec);
+
+// Reads every shard file of a sweep from `directory` into the collector and
+// reports the number of shards. Returns false (listing them) if any shard of
+// the sweep is missing or unreadable, or if the directory holds shard files of
+// sweeps with different shard counts.
+bool mergeShardFiles(const string& directory, ResultCollector& collector, size_t& shards);
+
+// Runs `shards` local copies of a command concurrently, without a shell, appending
+// "--shard I/N --shard-dir DIR" to each; output goes to shard-I-of-N.log in
+// the directory. Returns false if any shard exits unsuccessfully.
+bool runLocalShards(const vector<string>& command, size_t shards, const string& directory);
+
+#endif // SHARD_H
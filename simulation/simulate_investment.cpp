@@ -1,339 +1,739 @@
 // Includes standard C++ libraries for data structures, I/O, algorithms, and time handling
 #include <bits/stdc++.h>
+#include "market_data.h"
+#include "dataset_cache.h"
+#include "backtest.h"
+#include "sweep.h"
+#include "parameter_search.h"
+#include "monte_carlo.h"
+#include "checkpoint.h"
+#include "shard.h"
+#include "timeline_backtest.h"
+#include "price_bars.h"
+#include "walk_forward.h"
+#include "result_collector.h"
 using namespace std;
 using namespace chrono;
 
-// --- Data structures to store news and price entries ---
-
-// Represents a news event with associated company ticker, text similarity score,
-// sentiment score, and publication timestamp
-struct NewsEntry
-{
-    string ticker;                      // Stock symbol associated with the news
-    double similarity;                  // Similarity to company's profile
-    double sentiment;                  // Sentiment score of the news
-    system_clock::time_point timestamp; // Time when the news was published
-};
-
-// Represents a price record for a ticker at a specific timestamp
-struct PriceEntry 
-{
-    string ticker;                      // Stock symbol for the price data
-    double price;                       // Price of the stock at the given time
-    system_clock::time_point timestamp; // Time of the price record
-};
-
-// Represents a held position: quantity bought, purchase price and time
-struct InvestmentNode 
-{
-    string ticker;                      // Stock symbol for the investment
-    double quantity;                    // Number of shares bought
-    double buyPrice;                    // Price per share at purchase
-    system_clock::time_point buyTime;   // Timestamp when position was opened
-};
-
-// --- Global containers used during simulation ---
-
-// Mapping from ticker to its historical price records (sorted by time)
-map<string, vector<PriceEntry>> priceData;
-// Sequence of news events to feed into the simulation
-vector<NewsEntry> newsData;
-// Map of open positions per ticker: each holds a deque of InvestmentNode
-map<string, deque<InvestmentNode>> investmentMap;
-// Counter for how many simulation runs ended in profit
-int profitableSimulations = 0;
-
-// --- Function: simulate ---
-// Runs a single simulation with the given strategy parameters over loaded data.
-// investPercent: fraction of cash to allocate on each buy
-// buyThreshold: minimum sentiment score to trigger a buy
-// sellThreshold: maximum sentiment score to trigger a sell
-// similarityThreshold: minimum similarity to consider an event
-// holdDurationSecs: time (in seconds) to hold before forced sell
-// totalTrades: output parameter for count of buy actions
-// profitableTrades: output for count of profitable sells
-// winTrades/lossTrades: vectors to store P&L values for wins and losses
-// Returns final cash balance after running through all events
-
-double simulate(double investPercent,
-                double buyThreshold,
-                double sellThreshold,
-                double similarityThreshold,
-                int holdDurationSecs,
-                int &totalTrades,
-                int &profitableTrades,
-                vector<double> &winTrades,
-                vector<double> &lossTrades)
+// --- Grid: buildGrid ---
+// Enumerates the strategy grid in the same order as the original nested loops,
+// so indices (and tie-breaks between equal results) are stable across runs
+vector<GridPoint> buildGrid()
 {
-    double balance = 10000.0;       // Starting cash balance
-    totalTrades = profitableTrades = 0;
-    winTrades.clear();
-    lossTrades.clear();
-
-    // Iterate through each news event chronologically
-    for (auto const& news : newsData) 
-    {
-        // Skip events with low similarity
-        if (news.similarity < similarityThreshold) continue;
-
-        // Find the corresponding price at or just after the news timestamp
-        auto& prices = priceData[news.ticker];
-        auto it = lower_bound(prices.begin(), prices.end(), news.timestamp,
-            [](auto const& p, auto const& t){ return p.timestamp < t; });
-        if (it == prices.end()) continue;
-        double currentPrice = it->price;
-
-        // --- SELL: negative sentiment triggers closing all positions for ticker ---
-        if (news.sentiment <= sellThreshold) {
-            auto& invList = investmentMap[news.ticker];
-            while (!invList.empty()) 
+    vector<GridPoint> grid;
+    for (double invest = 0.005; invest <= 0.05; invest += 0.005) 
+    {
+        for (double buyT = 0.8; buyT <= 0.9; buyT += 0.05) 
+        {
+            for (double sellT = -0.5; sellT <= -0.1; sellT += 0.1) 
             {
-                auto node = invList.front();
-                double pnl = node.quantity * (currentPrice - node.buyPrice);
-                if (pnl > 0) 
-                {
-                    ++profitableTrades;
-                    winTrades.push_back(pnl);
-                } 
-                else 
+                for (double simT = 0.5; simT <= 0.65; simT += 0.05) 
                 {
-                    lossTrades.push_back(pnl);
+                    grid.push_back({invest, buyT, sellT, simT});
                 }
-                balance += node.quantity * currentPrice;
-                invList.pop_front();
             }
         }
-        // --- BUY: positive sentiment triggers opening a new position ---
-        else if (news.sentiment >= buyThreshold) 
-        {
-            double toInvest = balance * investPercent;
-            double qty = toInvest / currentPrice;
-            balance -= toInvest;
-            ++totalTrades;
-            investmentMap[news.ticker].push_back({
-                news.ticker, qty, currentPrice, news.timestamp
-            });
-        }
+    }
+    return grid;
+}
 
-        // --- Force SELL: positions exceeding hold duration are closed ---
-        for (auto& [_, queue] : investmentMap) 
+// --- Data loading: loadDataset ---
+// Maps the binary dataset cache if one is present, otherwise parses the CSVs
+// on `threads` threads
+void loadDataset(const string& datasetPath, unsigned threads)
+{
+    if (loadDatasetCache(datasetPath))
+    {
+        // Warn when the CSV exports were updated after the cache was built
+        error_code ec;
+        auto cacheTime = filesystem::last_write_time(datasetPath, ec);
+        for (const char* csv : {"news.csv", "prices.csv"})
         {
-            auto& invList = queue;
-            while (!invList.empty() &&
-                   duration_cast<seconds>(news.timestamp - invList.front().buyTime).count()
-                       >= holdDurationSecs)
+            error_code csvEc;
+            auto csvTime = filesystem::last_write_time(csv, csvEc);
+            if (!ec && !csvEc && csvTime > cacheTime)
             {
-                auto node = invList.front();
-                auto sellTime = node.buyTime + seconds(holdDurationSecs);
-                // Find price at forced sell time
-                auto it2 = lower_bound(prices.begin(), prices.end(), sellTime,
-                    [](auto const& p, auto const& t){ return p.timestamp < t; });
-                if (it2 == prices.end()) break;
-                double sellPrice = it2->price;
-                double pnl = node.quantity * (sellPrice - node.buyPrice);
-                if (pnl > 0)
-                {
-                    ++profitableTrades;
-                    winTrades.push_back(pnl);
-                } 
-                else 
-                {
-                    lossTrades.push_back(pnl);
-                }
-                balance += node.quantity * sellPrice;
-                invList.pop_front();
+                cerr << "Warning: " << csv << " is newer than " << datasetPath
+                     << "; rerun with --convert to refresh the cache" << endl;
             }
         }
+        return;
     }
 
-    // Compute and print trade accuracy
-    double accuracy = totalTrades
-        ? static_cast<double>(profitableTrades) / totalTrades * 100.0
+    loadNews("news.csv", threads);
+    loadPrices("prices.csv", threads);
+}
+
+// --- Reporting: printRun ---
+// Prints the trade statistics of one grid point
+void printRun(const SweepResult& r)
+{
+    double accuracy = r.trades
+        ? static_cast<double>(r.profitable) / r.trades * 100.0
         : 0.0;
-    cout << " -> Trades: " << totalTrades
-         << ", Profitable: " << profitableTrades
+    cout << " -> Trades: " << r.trades
+         << ", Profitable: " << r.profitable
          << ", Accuracy: " << accuracy << "%\n";
+    cout << "    Best win: " << r.bestWin
+         << ", Median win: " << r.medWin << "\n"
+         << "    Worst loss: " << r.bestLoss
+         << ", Median loss: " << r.medLoss << "\n";
+    cout << "    Expected return: " << r.expectedReturn << "\n"
+         << "    Volatility: " << r.volatility << ", Sharpe: " << r.sharpe
+         << ", Max drawdown: " << r.maxDrawdown << "\n";
+    cout << "Result " << r.result << " for: "
+         << r.params.invest << ' ' << r.params.buyT << ' ' << r.params.sellT << ' ' << r.params.simT;
+    if (r.params.holdSecs != 86400) cout << ' ' << r.params.holdSecs << 's';
+    cout << "\n\n";
+}
 
-    // Track if this simulation was profitable overall
-    if (balance > 10000.0) 
+// --- Reporting: printSummary ---
+// Prints the best-result and best-expected-return strategies and the tallies.
+// A strategy only counts as best once its score is above zero; equal scores
+// resolve to the earliest grid point, as in the original serial sweep.
+void printSummary(const ResultCollector& collector)
+{
+    SweepResult none{};
+    vector<SweepResult> byBalance = collector.topByBalance();
+    vector<SweepResult> byExpected = collector.topByExpectedReturn();
+    const SweepResult& bestResult =
+        !byBalance.empty() && byBalance.front().result > 0.0 ? byBalance.front() : none;
+    const SweepResult& bestExpected =
+        !byExpected.empty() && byExpected.front().expectedReturn > 0.0 ? byExpected.front() : none;
+
+    // Hold duration is only shown when a search varied it
+    auto holdNote = [](const GridPoint& p)
     {
-        profitableSimulations++;
-    }
+        return p.holdSecs == 86400 ? string() : ", hold " + to_string(p.holdSecs) + "s";
+    };
 
-    return balance;
+    // Print summary of top strategies
+    auto const& p1 = bestResult.params;
+    cout << "\nBest result strategy: invest " << p1.invest * 100 << "%, buy>= " << p1.buyT
+         << ", sell<= " << p1.sellT << ", similarity>= " << p1.simT << holdNote(p1) << "\n"
+         << "Final balance: $" << bestResult.result << endl;
+
+    auto const& p2 = bestExpected.params;
+    cout << "\nBest expected strategy: invest " << p2.invest * 100 << "%, buy>= " << p2.buyT
+         << ", sell<= " << p2.sellT << ", similarity>= " << p2.simT << holdNote(p2) << "\n"
+         << "Final balance: $" << bestExpected.result << "\n"
+         << "Expected return: " << bestExpected.expectedReturn << endl << endl;
+
+    cout << "Total simulations: " << collector.total()
+         << "\nProfitable simulations: " << collector.profitable() << endl << endl;
 }
 
-// --- Utility: parseTime ---
-// Converts an ISO-8601 timestamp string into a time_point
-system_clock::time_point parseTime(const string& iso) 
+// --- Reporting: printTop ---
+// Prints a ranked list of results under a heading
+void printTop(const string& heading, const vector<SweepResult>& ranked)
 {
-    tm t{};
-    sscanf(iso.c_str(), "%4d-%2d-%2dT%2d:%2d:%2d",
-           &t.tm_year, &t.tm_mon, &t.tm_mday,
-           &t.tm_hour, &t.tm_min, &t.tm_sec);
-    t.tm_year -= 1900;
-    t.tm_mon -= 1;
-    return system_clock::from_time_t(mktime(&t));
+    cout << heading << ":\n\n";
+    for (auto const& r : ranked) printRun(r);
 }
 
-// --- Data loading: loadNews ---
-// Reads a CSV of news entries, parses fields, and fills newsData vector
-void loadNews(const string& file) 
+// --- Search mode: runSearchMode ---
+// Runs the optimizer described by a search config and prints the best candidates
+int runSearchMode(const string& configPath, unsigned threads, size_t batchSize,
+                  size_t top, ResultWriter* writer)
 {
-    ifstream in(file);
-    if (!in.is_open()) {
-        cerr << "Failed to open news file!" << endl;
-        return;
+    SearchConfig cfg;
+    try
+    {
+        cfg = loadSearchConfig(configPath);
+    }
+    catch (const exception& e)
+    {
+        cerr << e.what() << endl;
+        return 1;
     }
 
-    string line;
-    int count = 0;
-    while (getline(in, line)) 
+    cout << "Running " << cfg.method << " search on " << threads << " threads" << endl;
+    SearchOutcome outcome = runSearch(cfg, threads, batchSize);
+    cout << "Search finished: " << outcome.evaluations << " evaluations in "
+         << outcome.seconds << " s, " << outcome.results.size()
+         << " on the full timeline" << endl << endl;
+
+    // Show the best full-timeline candidates by the search objective
+    TopResults ranked(top, objectiveOf(cfg));
+    for (auto const& r : outcome.results) ranked.offer(r);
+    for (auto const& r : ranked.sorted()) printRun(r);
+
+    ResultCollector collector(top, writer);
+    collector.add(outcome.results);
+    printSummary(collector);
+    return 0;
+}
+
+// --- Walk-forward mode: runWalkForwardMode ---
+// Fits the grid on each fold's train ranges and reports out-of-sample results
+int runWalkForwardMode(const WalkForwardConfig& cfg, unsigned threads, size_t batchSize)
+{
+    vector<Fold> folds;
+    try
+    {
+        folds = buildFolds(cfg, newsData.size());
+    }
+    catch (const exception& e)
     {
-        if (line.empty()) continue;
-        stringstream ss(line);
-        string name, ticker, sim, sent, time;
+        cerr << e.what() << endl;
+        return 1;
+    }
 
-        getline(ss, name, ',');
-        getline(ss, ticker, ',');
-        getline(ss, sim, ',');
-        getline(ss, sent, ',');
-        getline(ss, time);
+    vector<GridPoint> grid = buildGrid();
+    PriceLookupIndex lookup;
+    lookup.build(holdDurationsOf(grid));
 
-        if (ticker.empty() || sim.empty() || sent.empty() || time.empty()) 
-        {
-            cerr << "Skipping malformed line: " << line << endl;
-            continue;
-        }
+    cout << "Running " << (cfg.kFold ? "k-fold" : "walk-forward") << " validation: " << folds.size()
+         << " folds x " << grid.size() << " simulations on " << threads << " threads" << endl << endl;
+    vector<FoldResult> results = runWalkForward(folds, grid, lookup, threads, batchSize);
 
-        newsData.push_back({
-            ticker,
-            stod(sim),
-            stod(sent),
-            parseTime(time)
-        });
-        count++;
+    // Formats the publication date (UTC) of a news event
+    auto dateOf = [](size_t event)
+    {
+        time_t t = static_cast<time_t>(newsData[event].timestamp);
+        char buf[16];
+        strftime(buf, sizeof(buf), "%Y-%m-%d", gmtime(&t));
+        return string(buf);
+    };
+    auto describe = [&](EventRange r)
+    {
+        return dateOf(r.begin) + " .. " + dateOf(r.end - 1) + " (" + to_string(r.end - r.begin) + " events)";
+    };
+
+    double trainProfit = 0.0, testProfit = 0.0;
+    size_t trainEvents = 0, testEvents = 0;
+    int testTrades = 0, testProfitable = 0, profitableFolds = 0;
+    for (size_t f = 0; f < results.size(); ++f)
+    {
+        auto const& r = results[f];
+        auto const& p = r.train.params;
+        cout << "Fold " << f + 1 << ":\n";
+        for (auto const& range : r.fold.train) cout << "    train " << describe(range) << "\n";
+        cout << "    test  " << describe(r.fold.test) << "\n";
+        cout << "    fitted: invest " << p.invest * 100 << "%, buy>= " << p.buyT
+             << ", sell<= " << p.sellT << ", similarity>= " << p.simT << "\n";
+        cout << "    in-sample profit: $" << r.train.profit << " (" << r.train.trades << " trades)\n";
+
+        double profit = r.test.result - 10000.0;
+        double accuracy = r.test.trades
+            ? static_cast<double>(r.test.profitable) / r.test.trades * 100.0
+            : 0.0;
+        cout << "    out-of-sample profit: $" << profit << " (" << r.test.trades
+             << " trades, accuracy " << accuracy << "%)\n\n";
+
+        trainProfit += r.train.profit;
+        testProfit += profit;
+        for (auto const& range : r.fold.train) trainEvents += range.end - range.begin;
+        testEvents += r.fold.test.end - r.fold.test.begin;
+        testTrades += r.test.trades;
+        testProfitable += r.test.profitable;
+        if (profit > 0) ++profitableFolds;
     }
 
-    cout << "Loaded " << count << " news entries." << endl;
+    // Out-of-sample totals; efficiency compares profit per event out of and in sample
+    // (only meaningful when the fitted strategies made money in sample)
+    string efficiency = "n/a";
+    if (trainProfit > 0.0 && trainEvents && testEvents)
+    {
+        efficiency = to_string((testProfit / testEvents) / (trainProfit / trainEvents));
+    }
+    cout << "Out-of-sample profit: $" << testProfit
+         << " (mean $" << testProfit / results.size() << " per fold)\n"
+         << "Profitable folds: " << profitableFolds << " of " << results.size() << "\n"
+         << "Out-of-sample trades: " << testTrades << ", Profitable: " << testProfitable
+         << ", Accuracy: " << (testTrades ? static_cast<double>(testProfitable) / testTrades * 100.0 : 0.0)
+         << "%\n"
+         << "Walk-forward efficiency: " << efficiency << endl << endl;
+    return 0;
 }
 
-// --- Data loading: loadPrices ---
-// Reads a CSV of price entries and appends to priceData map
-void loadPrices(const string& file) 
+// --- Monte Carlo mode: runMonteCarloMode ---
+// Sweeps the fixed grid, then stress-tests the top candidates by final balance
+// on resampled news timelines and prints their outcome intervals
+int runMonteCarloMode(const MonteCarloConfig& mc, unsigned threads, size_t batchSize, size_t top)
 {
-    ifstream in(file);
-    if (!in.is_open()) 
+    vector<GridPoint> grid = buildGrid();
+    PriceLookupIndex lookup;
+    lookup.build(holdDurationsOf(grid));
+
+    SweepOptions options;
+    options.threads = threads;
+    options.batchSize = batchSize;
+    ResultCollector collector(top);
+    options.collector = &collector;
+
+    cout << "Running " << grid.size() << " simulations on " << threads << " threads" << endl;
+    runSweep(grid, lookup, options);
+    vector<SweepResult> candidates = collector.topByBalance();
+
+    cout << "Running " << mc.runs << " Monte Carlo runs for each of the top " << candidates.size()
+         << " candidates (block " << mc.blockSize << ", jitter " << mc.jitterSeconds
+         << "s, drop " << mc.dropProbability * 100 << "%, seed " << mc.seed << ")" << endl << endl;
+    for (auto const& c : candidates)
     {
-        cerr << "Failed to open prices file!" << endl;
-        return;
+        MonteCarloSummary s = runMonteCarlo(c.params, lookup, mc, threads);
+        auto const& p = s.params;
+        cout << "Invest " << p.invest * 100 << "%, buy>= " << p.buyT << ", sell<= " << p.sellT
+             << ", similarity>= " << p.simT << " (history: $" << c.result << ")\n"
+             << "    Balance: mean $" << s.meanBalance << ", std $" << s.stdBalance
+             << ", median $" << s.balanceMedian
+             << ", 95% interval [$" << s.balanceLow << ", $" << s.balanceHigh << "]\n"
+             << "    Accuracy: mean " << s.meanAccuracy << "%, 95% interval ["
+             << s.accuracyLow << "%, " << s.accuracyHigh << "%]\n"
+             << "    Profitable runs: " << s.profitProbability * 100 << "%\n\n";
     }
+    cout << flush;
+    return 0;
+}
 
-    string line;
-    int count = 0;
-    while (getline(in, line)) 
+// --- Checkpoint mode: runCheckpointMode ---
+// Sweeps the fixed grid from the end state saved in a checkpoint file (or from
+// scratch when there is none), prints the results and saves the new end state
+int runCheckpointMode(const string& path, unsigned threads, bool quiet, size_t top, ResultWriter* writer)
+{
+    vector<GridPoint> grid = buildGrid();
+    SweepCheckpoint checkpoint;
+    size_t first = 0;
+    if (filesystem::exists(path))
     {
-        stringstream ss(line);
-        string ticker, priceStr, time;
-        getline(ss, ticker, ',');
-        getline(ss, priceStr, ',');
-        getline(ss, time);
-
-        priceData[ticker].push_back({
-            ticker,
-            stod(priceStr),
-            parseTime(time)
-        });
-        count++;
+        if (!loadCheckpoint(path, checkpoint)) return 1;
+        if (!checkpointMatchesGrid(checkpoint, grid))
+        {
+            cerr << "Checkpoint " << path << " was written for a different grid; starting from scratch" << endl;
+            checkpoint = SweepCheckpoint();
+        }
+        else if ((first = resumeEvent(checkpoint)) > newsData.size())
+        {
+            cerr << "Loaded news does not extend checkpoint " << path << "; starting from scratch" << endl;
+            checkpoint = SweepCheckpoint();
+            first = 0;
+        }
     }
 
-    cout << "Loaded " << count << " price entries." << endl;
+    // Only events after the checkpoint are simulated, so only they need prices
+    PriceLookupIndex lookup;
+    lookup.build(holdDurationsOf(grid), first);
+
+    cout << "Running " << grid.size() << " simulations on " << threads << " threads from event "
+         << first << " of " << newsData.size() << endl;
+    vector<SweepResult> results = runCheckpointedSweep(grid, lookup, threads, checkpoint);
+    if (!saveCheckpoint(path, checkpoint)) return 1;
+
+    ResultCollector collector(top, writer);
+    collector.add(results);
+    if (quiet)
+    {
+        printTop("Top " + to_string(top) + " by final balance", collector.topByBalance());
+        printTop("Top " + to_string(top) + " by expected return", collector.topByExpectedReturn());
+    }
+    else
+    {
+        for (auto const& r : results) printRun(r);
+    }
+    printSummary(collector);
+    return 0;
 }
 
-// --- Helper: medianOf ---
-// Returns median element from a vector (assumes non-empty call handled by caller)
-template<typename T>
-T medianOf(vector<T>& v) 
+// --- Shard mode: runShardMode ---
+// Sweeps one shard of the fixed grid, with the same exit rules as the full sweep,
+// and writes its results to the shared directory
+int runShardMode(const ShardSpec& shard, const string& directory, unsigned threads, size_t batchSize,
+                 bool useTimeline, double stopLoss, double takeProfit)
 {
-    if (v.empty()) return T(0);
-    sort(v.begin(), v.end());
-    return v[v.size() / 2];
+    vector<GridPoint> grid = buildGrid();
+    auto [first, last] = shardBounds(grid.size(), shard);
+    vector<GridPoint> part(grid.begin() + first, grid.begin() + last);
+    PriceLookupIndex lookup;
+    MarketTimeline timeline;
+    PriceBarCache bars;
+    if (useTimeline)
+    {
+        timeline.build();
+    }
+    else
+    {
+        lookup.build(holdDurationsOf(part));
+        if (stopLoss > 0 || takeProfit > 0) bars.build();
+    }
+
+    error_code ec;
+    filesystem::create_directories(directory, ec);
+    string path = shardFilePath(directory, shard);
+    ResultWriter writer;
+    if (!writer.open(path)) return 1;
+
+    // Global grid indices keep the merged ranking identical to a single sweep
+    ResultCollector collector(0, &writer);
+    SweepOptions options;
+    options.threads = threads;
+    options.batchSize = batchSize;
+    options.collector = &collector;
+    options.firstIndex = first;
+    options.stopLoss = stopLoss;
+    options.takeProfit = takeProfit;
+    if (useTimeline) options.timeline = &timeline;
+    else if (stopLoss > 0 || takeProfit > 0) options.bars = &bars;
+
+    cout << "Running shard " << shard.index << "/" << shard.count << ": grid points " << first
+         << " to " << last << " of " << grid.size() << " on " << threads << " threads" << endl;
+    runSweep(part, lookup, options);
+    if (!writer.close()) return 1;
+    cout << "Wrote " << collector.total() << " results to " << path << endl;
+    return 0;
 }
 
-// --- Main: parameter sweep ---
-int main() {
-    loadNews("news.csv");
-    loadPrices("prices.csv");
+// --- Merge mode: runMergeMode ---
+// Combines the shard files in a directory and prints the global rankings and summary
+int runMergeMode(const string& directory, size_t top, ResultWriter* writer)
+{
+    ResultCollector collector(top, writer);
+    size_t shards = 0;
+    if (!mergeShardFiles(directory, collector, shards)) return 1;
 
-    double bestResult = 0.0;
-    double bestExpectedReturn = 0.0;
-    double bestExpectedResult = 0.0;
-    tuple<double,double,double,double> bestResultParams, bestExpectedParams;
-    int totalSimulations = 0;
+    size_t expected = buildGrid().size();
+    cout << "Merged " << collector.total() << " results from " << shards << " shards" << endl;
+    if (collector.total() != expected)
+    {
+        cerr << "Expected " << expected << " results; the shards do not cover the grid exactly" << endl;
+    }
+    printTop("Top " + to_string(top) + " by final balance", collector.topByBalance());
+    printTop("Top " + to_string(top) + " by expected return", collector.topByExpectedReturn());
+    printSummary(collector);
+    return collector.total() == expected ? 0 : 1;
+}
 
-    // Outer loops: grid search over strategy parameters
-    for (double invest = 0.005; invest <= 0.05; invest += 0.005) 
+// --- Main: parameter sweep ---
+// Usage: simulate [--threads N] [--batch N] [--dataset FILE] [--convert FILE] [--search FILE]
+//                 [--walk-forward N [--train-slices M]] [--kfold K]
+//                 [--quiet] [--top K] [--results FILE]
+//                 [--monte-carlo RUNS [--mc-block N] [--mc-jitter S] [--mc-drop P] [--mc-seed N]]
+//                 [--checkpoint FILE]
+//                 [--shards N | --shard I/N | --merge DIR] [--shard-dir DIR]
+//                 [--timeline] [--stop-loss F] [--take-profit F]
+//   --threads N      number of sweep workers (defaults to all hardware threads)
+//   --batch N        strategies evaluated together per pass over the news
+//                    (default 32; 1 runs simulate() once per grid point)
+//   --dataset FILE   binary dataset cache to map (default dataset.bin); falls back
+//                    to news.csv/prices.csv when it does not exist
+//   --convert FILE   parse the CSVs, write them as a dataset cache and exit
+//   --search FILE    run the optimizer configured in FILE instead of the fixed grid
+//   --walk-forward N fit the grid on M rolling slices of the timeline (default 3)
+//                    and test on the next one, for N folds
+//   --kfold K        cut the timeline into K slices; test on each, train on the rest
+//   --quiet          skip the per-run report; print the top K by balance and by
+//                    expected return instead
+//   --top K          how many best results to keep and print (default 10)
+//   --results FILE   stream every result to FILE (CSV, or binary if it ends in .bin)
+//   --monte-carlo RUNS  re-run the top K grid points on RUNS resampled timelines each
+//   --mc-block N     bootstrap block length in events (default 64; 0 keeps the history order)
+//   --mc-jitter S    shift each event by up to +/- S seconds (default 0)
+//   --mc-drop P      drop each event with probability P (default 0)
+//   --mc-seed N      base random seed (default 1)
+//   --checkpoint FILE  resume the grid from the end state saved in FILE, simulate
+//                    only the news added since, and save the new end state
+//   --shard I/N      sweep only shard I (0-based) of N grid index ranges and write
+//                    its results to the shard directory, for merging later
+//   --shard-dir DIR  shared directory of shard result files (default shards)
+//   --merge DIR      merge the shard files in DIR and print the global results
+//   --shards N       run N shards as local processes, then merge them
+//   --timeline       simulate on the merged news/price timeline, closing positions
+//                    on the first tick after their hold duration
+//   --stop-loss F    close a position once the price falls F (a fraction, e.g. 0.05)
+//                    below its buy price; found through precomputed OHLC bars unless
+//                    --timeline is given
+//   --take-profit F  close a position once the price rises F above its buy price
+int main(int argc, char* argv[]) {
+    unsigned threads = thread::hardware_concurrency();
+    size_t batchSize = 32;
+    string datasetPath = "dataset.bin";
+    string convertPath;
+    string searchPath;
+    WalkForwardConfig walkForward;
+    bool validate = false;
+    bool quiet = false;
+    size_t top = 10;
+    string resultsPath;
+    MonteCarloConfig monteCarlo;
+    bool robustness = false;
+    string checkpointPath;
+    ShardSpec shard;
+    bool sharded = false;
+    size_t localShards = 0;
+    string shardDir = "shards";
+    string mergeDir;
+    bool useTimeline = false;
+    double stopLoss = 0.0;
+    double takeProfit = 0.0;
+    for (int i = 1; i < argc; ++i)
     {
-        for (double buyT = 0.8; buyT <= 0.9; buyT += 0.05) 
+        string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc)
         {
-            for (double sellT = -0.5; sellT <= -0.1; sellT += 0.1) 
+            threads = static_cast<unsigned>(stoul(argv[++i]));
+        }
+        else if (arg == "--batch" && i + 1 < argc)
+        {
+            batchSize = max<size_t>(stoul(argv[++i]), 1);
+        }
+        else if (arg == "--dataset" && i + 1 < argc)
+        {
+            datasetPath = argv[++i];
+        }
+        else if (arg == "--convert" && i + 1 < argc)
+        {
+            convertPath = argv[++i];
+        }
+        else if (arg == "--search" && i + 1 < argc)
+        {
+            searchPath = argv[++i];
+        }
+        else if ((arg == "--walk-forward" || arg == "--kfold") && i + 1 < argc)
+        {
+            validate = true;
+            walkForward.kFold = arg == "--kfold";
+            walkForward.folds = stoul(argv[++i]);
+        }
+        else if (arg == "--train-slices" && i + 1 < argc)
+        {
+            walkForward.trainSlices = stoul(argv[++i]);
+        }
+        else if (arg == "--quiet")
+        {
+            quiet = true;
+        }
+        else if (arg == "--top" && i + 1 < argc)
+        {
+            top = stoul(argv[++i]);
+        }
+        else if (arg == "--results" && i + 1 < argc)
+        {
+            resultsPath = argv[++i];
+        }
+        else if (arg == "--monte-carlo" && i + 1 < argc)
+        {
+            robustness = true;
+            monteCarlo.runs = stoul(argv[++i]);
+        }
+        else if (arg == "--mc-block" && i + 1 < argc)
+        {
+            monteCarlo.blockSize = stoul(argv[++i]);
+        }
+        else if (arg == "--mc-jitter" && i + 1 < argc)
+        {
+            monteCarlo.jitterSeconds = stoll(argv[++i]);
+        }
+        else if (arg == "--mc-drop" && i + 1 < argc)
+        {
+            monteCarlo.dropProbability = stod(argv[++i]);
+        }
+        else if (arg == "--mc-seed" && i + 1 < argc)
+        {
+            monteCarlo.seed = stoull(argv[++i]);
+        }
+        else if (arg == "--checkpoint" && i + 1 < argc)
+        {
+            checkpointPath = argv[++i];
+        }
+        else if (arg == "--shard" && i + 1 < argc)
+        {
+            sharded = parseShardSpec(argv[++i], shard);
+            if (!sharded)
             {
-                for (double simT = 0.5; simT <= 0.65; simT += 0.05) 
-                {
-                    investmentMap.clear();
-
-                    int trades = 0, profitable = 0;
-                    vector<double> wins, losses;
-                    double result = simulate(
-                        invest, buyT, sellT, simT,
-                        86400, trades, profitable, wins, losses
-                    );
-                    ++totalSimulations;
-
-                    // Compute statistics on trade outcomes
-                    double bestWin  = wins.empty()  ? 0 : *max_element(wins.begin(), wins.end());
-                    double bestLoss = losses.empty()? 0 : *min_element(losses.begin(), losses.end());
-                    double medWin   = medianOf(wins);
-                    double medLoss  = medianOf(losses);
-                    double expectedReturn = profitable * medWin + (trades - profitable) * medLoss;
-
-                    cout << "    Best win: " << bestWin
-                         << ", Median win: " << medWin << "\n"
-                         << "    Worst loss: " << bestLoss
-                         << ", Median loss: " << medLoss << endl;
-                    cout << "    Expected return: " << expectedReturn << endl;
-                    cout << "Result " << result << " for: "
-                         << invest << ' ' << buyT << ' ' << sellT << ' ' << simT << endl << endl;
-
-                    // Track best overall result and best expected-return strategy
-                    if (result > bestResult) {
-                        bestResult = result;
-                        bestResultParams = {invest, buyT, sellT, simT};
-                    }
-                    if (expectedReturn > bestExpectedReturn) {
-                        bestExpectedReturn = expectedReturn;
-                        bestExpectedParams = {invest, buyT, sellT, simT};
-                        bestExpectedResult = result;
-                    }
-                }
+                cerr << "Invalid shard " << argv[i] << "; expected I/N with 0 <= I < N" << endl;
+                return 1;
             }
         }
+        else if (arg == "--shard-dir" && i + 1 < argc)
+        {
+            shardDir = argv[++i];
+        }
+        else if (arg == "--shards" && i + 1 < argc)
+        {
+            localShards = max<size_t>(stoul(argv[++i]), 1);
+        }
+        else if (arg == "--merge" && i + 1 < argc)
+        {
+            mergeDir = argv[++i];
+        }
+        else if (arg == "--timeline")
+        {
+            useTimeline = true;
+        }
+        else if (arg == "--stop-loss" && i + 1 < argc)
+        {
+            stopLoss = stod(argv[++i]);
+        }
+        else if (arg == "--take-profit" && i + 1 < argc)
+        {
+            takeProfit = stod(argv[++i]);
+        }
+        else
+        {
+            cerr << "Usage: " << argv[0]
+                 << " [--threads N] [--batch N] [--dataset FILE] [--convert FILE] [--search FILE]"
+                 << " [--walk-forward N [--train-slices M]] [--kfold K]"
+                 << " [--quiet] [--top K] [--results FILE]"
+                 << " [--monte-carlo RUNS [--mc-block N] [--mc-jitter S] [--mc-drop P] [--mc-seed N]]"
+                 << " [--checkpoint FILE]"
+                 << " [--shards N | --shard I/N | --merge DIR] [--shard-dir DIR]"
+                 << " [--timeline] [--stop-loss F] [--take-profit F]" << endl;
+            return 1;
+        }
+    }
+    if (threads == 0) threads = 1;
+    if (monteCarlo.jitterSeconds < 0 || monteCarlo.dropProbability < 0 || monteCarlo.dropProbability >= 1)
+    {
+        cerr << "--mc-jitter must be >= 0 and --mc-drop in [0, 1)" << endl;
+        return 1;
     }
 
-    // Print summary of top strategies
-    auto [i1, b1, s1, sim1] = bestResultParams;
-    cout << "\nBest result strategy: invest " << i1 * 100 << "%, buy>= " << b1
-         << ", sell<= " << s1 << ", similarity>= " << sim1 << "\n"
-         << "Final balance: $" << bestResult << endl;
+    // Walk-forward and Monte Carlo runs print their folds and candidates but write no result rows
+    if (!resultsPath.empty() && (validate || robustness))
+    {
+        cerr << "--results cannot be combined with --walk-forward, --kfold or --monte-carlo" << endl;
+        return 1;
+    }
 
-    auto [i2, b2, s2, sim2] = bestExpectedParams;
-    cout << "\nBest expected strategy: invest " << i2 * 100 << "%, buy>= " << b2
-         << ", sell<= " << s2 << ", similarity>= " << sim2 << "\n"
-         << "Final balance: $" << bestExpectedResult << "\n"
-         << "Expected return: " << bestExpectedReturn << endl << endl;
+    // Timeline and stop/target exits are only implemented for the grid sweep and its shards
+    bool exitRules = useTimeline || stopLoss > 0 || takeProfit > 0;
+    if (exitRules && (!searchPath.empty() || validate || robustness || !checkpointPath.empty()))
+    {
+        cerr << "--timeline, --stop-loss and --take-profit only apply to the grid sweep; they cannot be"
+             << " combined with --search, --walk-forward, --kfold, --monte-carlo or --checkpoint" << endl;
+        return 1;
+    }
 
-    cout << "Total simulations: " << totalSimulations
-         << "\nProfitable simulations: " << profitableSimulations << endl << endl;
+    // Shards sweep the fixed grid only; the other modes are not split across processes
+    if ((sharded || localShards > 0) && (!searchPath.empty() || validate || robustness || !checkpointPath.empty()))
+    {
+        cerr << "--shard and --shards only split the fixed grid sweep; they cannot be combined with"
+             << " --search, --walk-forward, --kfold, --monte-carlo or --checkpoint" << endl;
+        return 1;
+    }
 
-    return 0;
+    // One-time conversion of the CSV exports into the binary format
+    if (!convertPath.empty())
+    {
+        loadNews("news.csv", threads);
+        loadPrices("prices.csv", threads);
+        return writeDatasetCache(convertPath) ? 0 : 1;
+    }
+
+    ResultWriter writer;
+    if (!resultsPath.empty() && !writer.open(resultsPath))
+    {
+        return 1;
+    }
+    ResultWriter* resultWriter = resultsPath.empty() ? nullptr : &writer;
+
+    // Closes the results file; a run whose results could not all be written fails
+    auto finish = [&](int status)
+    {
+        return writer.close() ? status : 1;
+    };
+
+    // Merging and coordinating only read result files; the shards load the data
+    if (!mergeDir.empty())
+    {
+        return finish(runMergeMode(mergeDir, top, resultWriter));
+    }
+    if (localShards > 0)
+    {
+        unsigned shardThreads = max<unsigned>(1, threads / localShards);
+        vector<string> command = {argv[0], "--dataset", datasetPath, "--batch", to_string(batchSize),
+                                  "--threads", to_string(shardThreads)};
+
+        // Exit rules go to every shard, written exactly so each one simulates the same strategies
+        auto exact = [](double value)
+        {
+            ostringstream out;
+            out << setprecision(17) << value;
+            return out.str();
+        };
+        if (useTimeline) command.push_back("--timeline");
+        if (stopLoss > 0) command.insert(command.end(), {"--stop-loss", exact(stopLoss)});
+        if (takeProfit > 0) command.insert(command.end(), {"--take-profit", exact(takeProfit)});
+        cout << "Running " << localShards << " shards with " << shardThreads << " threads each in "
+             << shardDir << endl;
+        if (!runLocalShards(command, localShards, shardDir)) return 1;
+        return finish(runMergeMode(shardDir, top, resultWriter));
+    }
+
+    loadDataset(datasetPath, threads);
+
+    if (sharded)
+    {
+        return runShardMode(shard, shardDir, threads, batchSize, useTimeline, stopLoss, takeProfit);
+    }
+
+    if (!searchPath.empty())
+    {
+        return finish(runSearchMode(searchPath, threads, batchSize, top, resultWriter));
+    }
+    if (validate)
+    {
+        return runWalkForwardMode(walkForward, threads, batchSize);
+    }
+    if (robustness)
+    {
+        return runMonteCarloMode(monteCarlo, threads, batchSize, top);
+    }
+    if (!checkpointPath.empty())
+    {
+        return finish(runCheckpointMode(checkpointPath, threads, quiet, top, resultWriter));
+    }
+
+    // Resolve every price lookup once; all grid points share the index read-only.
+    // The timeline kernel walks the merged timeline instead.
+    vector<GridPoint> grid = buildGrid();
+    PriceLookupIndex lookup;
+    MarketTimeline timeline;
+    PriceBarCache bars;
+    SweepOptions options;
+    options.threads = threads;
+    options.batchSize = batchSize;
+    options.stopLoss = stopLoss;
+    options.takeProfit = takeProfit;
+    if (useTimeline)
+    {
+        timeline.build();
+        options.timeline = &timeline;
+        cout << "Merged " << timeline.events.size() << " news and price events into one timeline"
+             << " (stop-loss " << stopLoss * 100 << "%, take-profit " << takeProfit * 100 << "%)" << endl;
+    }
+    else
+    {
+        lookup.build(holdDurationsOf(grid));
+    }
+
+    // Stop-loss / take-profit exits are found in the bar hierarchy unless the
+    // timeline was asked for explicitly
+    if (!useTimeline && (stopLoss > 0 || takeProfit > 0))
+    {
+        bars.build();
+        options.bars = &bars;
+        cout << "Built price bars:";
+        for (auto const& level : bars.levels()) cout << " " << level.seconds << "s x " << level.bars.size();
+        cout << " (stop-loss " << stopLoss * 100 << "%, take-profit " << takeProfit * 100 << "%)" << endl;
+    }
+
+    cout << "Running " << grid.size() << " simulations on " << threads << " threads" << endl;
+    ResultCollector collector(top, resultWriter);
+    if (quiet)
+    {
+        // Results stream straight into the collector; nothing per run is kept
+        options.collector = &collector;
+        runSweep(grid, lookup, options);
+        printTop("Top " + to_string(top) + " by final balance", collector.topByBalance());
+        printTop("Top " + to_string(top) + " by expected return", collector.topByExpectedReturn());
+    }
+    else
+    {
+        vector<SweepResult> results = runSweep(grid, lookup, options);
+        for (auto const& r : results) printRun(r);
+        collector.add(results);
+    }
+    printSummary(collector);
+
+    return finish(0);
 }
@@ -0,0 +1,285 @@
+// Includes standard C++ libraries and project-specific headers
+#include "sweep.h"
+#include "batch_backtest.h"
+#include "result_collector.h"
+#include "timeline_backtest.h"
+#include "price_bars.h"
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace chrono;
+
+// === SweepBudget ===
+
+SweepBudget::SweepBudget(size_t maxEvaluations, double maxSeconds)
+    : maxEvaluations(maxEvaluations), maxSeconds(maxSeconds), start(steady_clock::now())
+{
+}
+
+// Reserves `count` evaluations; returns false once the budget is spent.
+// A claim that starts below the evaluation limit is granted in full.
+bool SweepBudget::claim(size_t count)
+{
+    if (maxSeconds > 0 && elapsedSeconds() >= maxSeconds) return false;
+    size_t before = evaluations.load();
+    do
+    {
+        if (maxEvaluations > 0 && before >= maxEvaluations) return false;
+    }
+    while (!evaluations.compare_exchange_weak(before, before + count));
+    return true;
+}
+
+// True once either limit has been reached
+bool SweepBudget::exhausted() const
+{
+    return (maxSeconds > 0 && elapsedSeconds() >= maxSeconds) ||
+           (maxEvaluations > 0 && evaluations.load() >= maxEvaluations);
+}
+
+// Seconds since the budget was created
+double SweepBudget::elapsedSeconds() const
+{
+    return duration<double>(steady_clock::now() - start).count();
+}
+
+// === WorkStealingScheduler ===
+
+WorkStealingScheduler::WorkStealingScheduler(size_t count, unsigned workers)
+    : ranges(workers)
+{
+    // Split [0, count) into nearly equal contiguous slices
+    for (unsigned w = 0; w < workers; ++w)
+    {
+        ranges[w].begin = count * w / workers;
+        ranges[w].end = count * (w + 1) / workers;
+    }
+}
+
+// Fetches the next index for worker w, stealing if its own range is empty
+bool WorkStealingScheduler::next(unsigned w, size_t& index)
+{
+    if (popFront(w, index)) return true;
+
+    // Own range exhausted: scan the other workers for something to steal
+    for (size_t k = 1; k < ranges.size(); ++k)
+    {
+        auto& victim = ranges[(w + k) % ranges.size()];
+        size_t stolenBegin, stolenEnd;
+        {
+            lock_guard<mutex> lock(victim.m);
+            size_t remaining = victim.end - victim.begin;
+            if (remaining == 0) continue;
+
+            // Take the back half (at least one item) of the victim's range
+            size_t take = (remaining + 1) / 2;
+            stolenEnd = victim.end;
+            stolenBegin = victim.end - take;
+            victim.end = stolenBegin;
+        }
+
+        // Keep the first stolen index, publish the rest as our own range
+        {
+            lock_guard<mutex> lock(ranges[w].m);
+            ranges[w].begin = stolenBegin + 1;
+            ranges[w].end = stolenEnd;
+        }
+        index = stolenBegin;
+        return true;
+    }
+    return false;
+}
+
+// Takes the next index from the front of worker w's own range
+bool WorkStealingScheduler::popFront(unsigned w, size_t& index)
+{
+    lock_guard<mutex> lock(ranges[w].m);
+    if (ranges[w].begin == ranges[w].end) return false;
+    index = ranges[w].begin++;
+    return true;
+}
+
+// === Sweep functions ===
+
+// Condenses the trade outcomes of one simulation into a sweep result
+SweepResult summarizeRun(size_t index, const GridPoint& p, double result, int trades, int profitable,
+                         const TradeStats& stats)
+{
+    SweepResult r{};
+    r.index = index;
+    r.params = p;
+    r.result = result;
+    r.trades = trades;
+    r.profitable = profitable;
+
+    // Statistics were accumulated trade by trade during the run
+    r.bestWin  = stats.bestWin;
+    r.bestLoss = stats.worstLoss;
+    r.medWin   = stats.winMedian.value();
+    r.medLoss  = stats.lossMedian.value();
+    r.expectedReturn = r.profitable * r.medWin + (r.trades - r.profitable) * r.medLoss;
+    r.volatility = stats.volatility();
+    r.sharpe = stats.sharpe();
+    r.maxDrawdown = stats.maxDrawdown;
+    return r;
+}
+
+// Collects the distinct hold durations of a set of grid points
+vector<int> holdDurationsOf(const vector<GridPoint>& grid)
+{
+    vector<int> holds;
+    for (auto const& p : grid) holds.push_back(p.holdSecs);
+    sort(holds.begin(), holds.end());
+    holds.erase(unique(holds.begin(), holds.end()), holds.end());
+    return holds;
+}
+
+// Runs one simulation for a grid point and condenses its trade outcomes
+static SweepResult evaluateGridPoint(size_t index, const GridPoint& p, const PriceLookupIndex& lookup,
+                                     EventRange events, SimulationState& state, TradeStats& stats)
+{
+    int trades = 0, profitable = 0;
+    double result = simulate(p.invest, p.buyT, p.sellT, p.simT, p.holdSecs,
+                             lookup, state, trades, profitable, stats, events);
+    return summarizeRun(index, p, result, trades, profitable, stats);
+}
+
+// Runs one grid point with the merged-timeline kernel
+static SweepResult evaluateTimelinePoint(size_t index, const GridPoint& p, const SweepOptions& options,
+                                         TimelineState& state, TradeStats& stats)
+{
+    BracketStrategy strategy = makeBracketStrategy(p.invest, p.buyT, p.sellT, p.simT, p.holdSecs,
+                                                   options.stopLoss, options.takeProfit);
+    int trades = 0, profitable = 0;
+    double result = simulateTimeline(strategy, *options.timeline, state, trades, profitable, stats,
+                                     options.events);
+    return summarizeRun(index, p, result, trades, profitable, stats);
+}
+
+// Runs one grid point with the bar exit kernel
+static SweepResult evaluateBarPoint(size_t index, const GridPoint& p, const PriceLookupIndex& lookup,
+                                    const SweepOptions& options, BarState& state, TradeStats& stats)
+{
+    BracketStrategy strategy = makeBracketStrategy(p.invest, p.buyT, p.sellT, p.simT, p.holdSecs,
+                                                   options.stopLoss, options.takeProfit);
+    int trades = 0, profitable = 0;
+    double result = simulateBars(strategy, lookup, *options.bars, state, trades, profitable, stats,
+                                 options.events);
+    return summarizeRun(index, p, result, trades, profitable, stats);
+}
+
+// Runs grid points [first, first + count) with the batched kernel. The kernel
+// needs one hold duration per pass, so the block is split into runs of
+// consecutive points sharing a hold duration.
+static void evaluateGridBlock(size_t first, size_t count, const vector<GridPoint>& grid,
+                              const PriceLookupIndex& lookup, EventRange events, BatchState& state,
+                              vector<StrategyParams>& params, vector<StrategyOutcome>& outcomes,
+                              vector<SweepResult>& buffer)
+{
+    size_t end = first + count;
+    for (size_t runBegin = first; runBegin < end; )
+    {
+        int hold = grid[runBegin].holdSecs;
+        size_t runEnd = runBegin;
+        params.clear();
+        while (runEnd < end && grid[runEnd].holdSecs == hold)
+        {
+            auto const& p = grid[runEnd++];
+            params.push_back({p.invest, p.buyT, p.sellT, p.simT});
+        }
+
+        simulateBatch(params, hold, lookup, state, outcomes, events);
+
+        for (size_t k = 0; k < params.size(); ++k)
+        {
+            auto& o = outcomes[k];
+            buffer.push_back(summarizeRun(runBegin + k, grid[runBegin + k], o.balance, o.totalTrades,
+                                          o.profitableTrades, o.tradeStats));
+        }
+        runBegin = runEnd;
+    }
+}
+
+// Evaluates every grid point on options.threads workers.
+// With batchSize > 1 the unit of work is a block of consecutive grid points
+// evaluated together by the batched kernel.
+vector<SweepResult> runSweep(const vector<GridPoint>& grid, const PriceLookupIndex& lookup,
+                             const SweepOptions& options)
+{
+    // The timeline and bar kernels run one strategy per pass
+    size_t batchSize = options.timeline || options.bars ? 1 : max<size_t>(options.batchSize, 1);
+    size_t blocks = (grid.size() + batchSize - 1) / batchSize;
+    unsigned threads = max(1u, min<unsigned>(options.threads, max<size_t>(blocks, 1)));
+    WorkStealingScheduler scheduler(blocks, threads);
+    vector<vector<SweepResult>> buffers(threads);
+
+    auto worker = [&](unsigned w)
+    {
+        SimulationState state;            // Private open positions
+        TradeStats stats;                 // Trade statistics of the current run
+        BatchState batchState;            // Private lanes and lots for the batched kernel
+        TimelineState timelineState;      // Private positions for the timeline kernel
+        BarState barState;                // Private positions for the bar kernel
+        vector<StrategyParams> params;
+        vector<StrategyOutcome> outcomes;
+        size_t block;
+        while (scheduler.next(w, block))
+        {
+            size_t first = block * batchSize;
+            size_t count = min(batchSize, grid.size() - first);
+            if (options.budget && !options.budget->claim(count)) continue;
+
+            size_t produced = buffers[w].size();
+            if (options.timeline)
+            {
+                buffers[w].push_back(evaluateTimelinePoint(first, grid[first], options,
+                                                           timelineState, stats));
+            }
+            else if (options.bars)
+            {
+                buffers[w].push_back(evaluateBarPoint(first, grid[first], lookup, options, barState, stats));
+            }
+            else if (batchSize == 1)
+            {
+                buffers[w].push_back(evaluateGridPoint(first, grid[first], lookup, options.events,
+                                                       state, stats));
+            }
+            else
+            {
+                evaluateGridBlock(first, count, grid, lookup, options.events, batchState,
+                                  params, outcomes, buffers[w]);
+            }
+
+            for (size_t k = produced; k < buffers[w].size(); ++k) buffers[w][k].index += options.firstIndex;
+
+            // Stream the block out instead of keeping the whole sweep in memory
+            if (options.collector)
+            {
+                options.collector->add(buffers[w]);
+                buffers[w].clear();
+            }
+        }
+    };
+
+    if (threads == 1)
+    {
+        worker(0);
+    }
+    else
+    {
+        vector<thread> pool;
+        for (unsigned w = 0; w < threads; ++w) pool.emplace_back(worker, w);
+        for (auto& t : pool) t.join();
+    }
+
+    // Merge per-worker buffers back into grid order
+    vector<SweepResult> results;
+    results.reserve(grid.size());
+    for (auto& buffer : buffers)
+    {
+        results.insert(results.end(), buffer.begin(), buffer.end());
+    }
+    sort(results.begin(), results.end(),
+         [](auto const& a, auto const& b){ return a.index < b.index; });
+    return results;
+}
@@ -0,0 +1,132 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+// Includes standard C++ libraries and project-specific headers
+#include <bits/stdc++.h>
+#include "backtest.h"
+
+using namespace std;
+
+// === Data structures used by parameter sweeps ===
+
+// One point of the strategy parameter space
+struct GridPoint
+{
+    double invest;          // Fraction of cash allocated on each buy
+    double buyT;            // Minimum sentiment to buy
+    double sellT;           // Maximum sentiment to sell
+    double simT;            // Minimum similarity to consider an event
+    int holdSecs = 86400;   // Time to hold a position before the forced sell
+};
+
+// Outcome and trade statistics of a single grid point
+struct SweepResult
+{
+    size_t index;             // Position of the grid point in sweep order
+    GridPoint params;         // Strategy parameters used
+    double result;            // Final cash balance
+    int trades;               // Number of buys
+    int profitable;           // Number of profitable sells
+    double bestWin;           // Largest single winning trade
+    double bestLoss;          // Largest single losing trade
+    double medWin;            // Median winning trade
+    double medLoss;           // Median losing trade
+    double expectedReturn;    // profitable * medWin + losing * medLoss
+    double volatility;        // Standard deviation of trade P&L
+    double sharpe;            // Mean trade P&L / volatility
+    double maxDrawdown;       // Largest drop of cumulative realized P&L
+};
+
+// Evaluation budget shared by all workers of one or more sweeps.
+// A limit of 0 means unlimited.
+class SweepBudget
+{
+public:
+    SweepBudget(size_t maxEvaluations, double maxSeconds);
+
+    // Reserves `count` evaluations; returns false once the budget is spent
+    bool claim(size_t count);
+
+    // True once either limit has been reached
+    bool exhausted() const;
+
+    // Number of evaluations claimed so far
+    size_t used() const { return evaluations.load(); }
+
+    // Seconds since the budget was created
+    double elapsedSeconds() const;
+
+private:
+    size_t maxEvaluations;
+    double maxSeconds;
+    chrono::steady_clock::time_point start;
+    atomic<size_t> evaluations{0};
+};
+
+class ResultCollector;
+struct MarketTimeline;
+class PriceBarCache;
+
+// Settings of one sweep run
+struct SweepOptions
+{
+    unsigned threads = 1;           // Number of workers
+    size_t batchSize = 32;          // Strategies per batched-kernel pass (1 = simulate())
+    EventRange events;              // Part of the news timeline to simulate
+    SweepBudget* budget = nullptr;  // Optional shared budget; unclaimed points are skipped
+    ResultCollector* collector = nullptr;   // Optional sink; results are handed to it
+                                            // block by block instead of being returned
+    size_t firstIndex = 0;          // Index reported for grid[0] (a shard of a larger grid)
+    const MarketTimeline* timeline = nullptr;   // Optional merged timeline; when set, every
+                                                // point runs simulateTimeline() instead
+    const PriceBarCache* bars = nullptr;        // Optional bar cache; when set (and no timeline),
+                                                // every point runs simulateBars() instead
+    double stopLoss = 0.0;          // Timeline/bars: stop-loss fraction below the buy price (0 = off)
+    double takeProfit = 0.0;        // Timeline/bars: take-profit fraction above the buy price (0 = off)
+};
+
+// Each worker owns a contiguous range of work indices and takes work from its front.
+// A worker that runs dry steals the back half of another worker's remaining range,
+// so uneven run times (e.g. low thresholds that trade a lot) still balance out.
+class WorkStealingScheduler
+{
+public:
+    WorkStealingScheduler(size_t count, unsigned workers);
+
+    // Fetches the next index for worker w, stealing if its own range is empty.
+    // Returns false once no work is left anywhere.
+    bool next(unsigned w, size_t& index);
+
+private:
+    // Half-open index range owned by one worker
+    struct Range
+    {
+        mutex m;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    // Takes the next index from the front of worker w's own range
+    bool popFront(unsigned w, size_t& index);
+
+    vector<Range> ranges;
+};
+
+// === Sweep functions ===
+
+// Condenses the trade outcomes of one simulation into a sweep result
+SweepResult summarizeRun(size_t index, const GridPoint& p, double result, int trades, int profitable,
+                         const TradeStats& stats);
+
+// Collects the distinct hold durations of a set of grid points
+vector<int> holdDurationsOf(const vector<GridPoint>& grid);
+
+// Evaluates every grid point on options.threads workers. Each worker has its own
+// portfolio state and result buffer; the buffers are merged and ordered by grid
+// index afterwards, so the output does not depend on scheduling. Points skipped
+// because the budget ran out are missing from the result. With a collector the
+// results stream into it as blocks finish and the returned vector is empty.
+vector<SweepResult> runSweep(const vector<GridPoint>& grid, const PriceLookupIndex& lookup,
+                             const SweepOptions& options);
+
+#endif // SWEEP_H
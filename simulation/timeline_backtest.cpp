@@ -0,0 +1,82 @@
+// Includes standard C++ libraries and project-specific headers
+#include "timeline_backtest.h"
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// === MarketTimeline ===
+
+// K-way merges newsData with every ticker's price series
+void MarketTimeline::build()
+{
+    size_t tickers = priceData.tickerCount();
+    events.clear();
+    events.reserve(newsData.size() + priceData.recordCount());
+
+    // Cursor into one input stream; stream `tickers` is the news
+    struct Cursor
+    {
+        int64_t time;
+        uint32_t isNews;
+        TickerId stream;
+        size_t next;
+
+        // Min-heap ordering: time, then news before prices, then ticker ID
+        bool operator>(const Cursor& other) const
+        {
+            if (time != other.time) return time > other.time;
+            if (isNews != other.isNews) return isNews < other.isNews;
+            return stream > other.stream;
+        }
+    };
+
+    vector<PriceSeries> series(tickers);
+    vector<Cursor> heap;
+    heap.reserve(tickers + 1);
+    for (TickerId id = 0; id < tickers; ++id)
+    {
+        series[id] = priceData.series(id);
+        if (series[id].size) heap.push_back({series[id].timestamps[0], 0, id, 0});
+    }
+    if (!newsData.empty()) heap.push_back({newsData[0].timestamp, 1, static_cast<TickerId>(tickers), 0});
+    make_heap(heap.begin(), heap.end(), greater<Cursor>());
+
+    newsPosition.resize(newsData.size());
+    while (!heap.empty())
+    {
+        pop_heap(heap.begin(), heap.end(), greater<Cursor>());
+        Cursor& c = heap.back();
+        size_t length;
+        if (c.isNews)
+        {
+            const NewsEntry& news = newsData[c.next];
+            newsPosition[c.next] = events.size();
+            events.push_back({news.timestamp, news.tickerId, 1, static_cast<uint32_t>(c.next)});
+            length = newsData.size();
+        }
+        else
+        {
+            events.push_back({c.time, c.stream, 0, static_cast<uint32_t>(c.next)});
+            length = series[c.stream].size;
+        }
+
+        // Advance the stream, or drop it once it is exhausted
+        if (++c.next == length)
+        {
+            heap.pop_back();
+            continue;
+        }
+        c.time = c.isNews ? newsData[c.next].timestamp : series[c.stream].timestamps[c.next];
+        push_heap(heap.begin(), heap.end(), greater<Cursor>());
+    }
+
+    // Walking backwards, the last tick seen of a ticker is its next price
+    vector<uint64_t> nextTick(tickers, PriceLookupIndex::NO_PRICE);
+    newsEntry.resize(newsData.size());
+    for (size_t pos = events.size(); pos-- > 0; )
+    {
+        const TimelineEvent& e = events[pos];
+        if (e.isNews) newsEntry[e.ref] = nextTick[e.tickerId];
+        else nextTick[e.tickerId] = priceData.recordOffset(e.tickerId) + e.ref;
+    }
+}
@@ -0,0 +1,194 @@
+#ifndef TIMELINE_BACKTEST_H
+#define TIMELINE_BACKTEST_H
+
+// Includes standard C++ libraries and project-specific headers
+#include <bits/stdc++.h>
+#include "backtest.h"
+
+using namespace std;
+
+// === Merged news/price timeline ===
+
+// One step of the timeline: a news event or a price tick
+// (16 bytes, since every run streams the whole timeline)
+struct TimelineEvent
+{
+    int64_t time;               // Seconds since the epoch
+    uint32_t tickerId : 31;     // Ticker the news or price belongs to
+    uint32_t isNews : 1;        // 1 for news, 0 for a price tick
+    uint32_t ref;               // newsData index, or record index within the ticker's series
+};
+
+// Every news event and price record of the loaded dataset in one chronological
+// sequence, built once and shared read-only by every run. At equal times news
+// comes before prices, so the tick at a news event's own timestamp is the
+// first price after it; equal-time prices are ordered by ticker ID.
+struct MarketTimeline
+{
+    vector<TimelineEvent> events;
+
+    // Per news event: first price record of its ticker at or after the news time
+    // (PriceLookupIndex::NO_PRICE if there is none)
+    vector<uint64_t> newsEntry;
+
+    // Per news event: its position in `events`
+    vector<uint64_t> newsPosition;
+
+    // K-way merges newsData with every ticker's price series
+    void build();
+};
+
+// Per-run state of the timeline kernel. Each worker owns one and reuses it.
+struct TimelineState
+{
+    vector<PositionQueue> positions;    // Open positions by ticker, in buy order
+    vector<double> stopLevel;           // Per ticker: highest stop price of its open positions
+    vector<double> targetLevel;         // Per ticker: lowest target price of its open positions
+    uint64_t nextSeq = 0;               // Sequence number for the next opened position
+
+    // Drops all open positions before the next run (one slot per known ticker)
+    void reset()
+    {
+        size_t tickers = priceData.tickerCount();
+        positions.resize(tickers);
+        for (auto& q : positions) q.clear();
+        stopLevel.assign(tickers, -numeric_limits<double>::infinity());
+        targetLevel.assign(tickers, numeric_limits<double>::infinity());
+        nextSeq = 0;
+    }
+};
+
+// === Timeline kernel ===
+
+// Runs one strategy over the merged timeline, or over the part of it spanning
+// the news events in `events`. Unlike simulate(), which only acts at news
+// times, positions are checked on every price tick of their ticker:
+//   - a tick at or below a position's stop price or at or above its target
+//     price (Exit::stopPrice / Exit::targetPrice) closes it at the tick price;
+//   - the first tick at or after its expiry closes it (the price simulate()
+//     uses for the forced sell, but credited at the tick time).
+// Buys and sell signals trade at the first price at or after the news, as in
+// simulate(). The walk is linear; no price is searched for.
+template<typename Strategy>
+double simulateTimeline(const Strategy& strategy,
+                        const MarketTimeline& timeline,
+                        TimelineState& state,
+                        int& totalTrades,
+                        int& profitableTrades,
+                        TradeStats& tradeStats,
+                        EventRange range = {})
+{
+    double balance = 10000.0;       // Starting cash balance
+    state.reset();
+    totalTrades = profitableTrades = 0;
+    tradeStats.reset();
+
+    size_t end = min(range.end, newsData.size());
+    size_t begin = min(range.begin, end);
+    if (begin == end) return balance;
+    size_t first = timeline.newsPosition[begin];
+    size_t last = timeline.newsPosition[end - 1] + 1;
+
+    // Closes one position of a ticker at `price`
+    auto close = [&](const InvestmentNode& node, double price)
+    {
+        double pnl = node.quantity * (price - node.buyPrice);
+        if (pnl > 0) ++profitableTrades;
+        tradeStats.add(pnl);
+        balance += node.quantity * price;
+    };
+
+    // Recomputes a ticker's trigger levels from its open positions
+    auto refreshLevels = [&](TickerId id)
+    {
+        double stop = -numeric_limits<double>::infinity();
+        double target = numeric_limits<double>::infinity();
+        auto const& q = state.positions[id];
+        for (size_t k = q.head; k < q.nodes.size(); ++k)
+        {
+            stop = max(stop, strategy.exit.stopPrice(q.nodes[k].buyPrice));
+            target = min(target, strategy.exit.targetPrice(q.nodes[k].buyPrice));
+        }
+        state.stopLevel[id] = stop;
+        state.targetLevel[id] = target;
+    };
+
+    const TimelineEvent* events = timeline.events.data();
+    for (size_t pos = first; pos < last; ++pos)
+    {
+        const TimelineEvent& e = events[pos];
+        TickerId id = e.tickerId;
+        auto& q = state.positions[id];
+
+        if (e.isNews)
+        {
+            auto const& news = newsData[e.ref];
+            StrategyAction action = strategy.decide(news.similarity, news.sentiment);
+            if (action == StrategyAction::Ignore) continue;
+
+            uint64_t entryRecord = timeline.newsEntry[e.ref];
+            if (entryRecord == PriceLookupIndex::NO_PRICE) continue;
+            double currentPrice = priceData.recordPrice(entryRecord);
+
+            // --- SELL: negative sentiment closes all positions for the ticker ---
+            if (action == StrategyAction::Sell)
+            {
+                for (size_t k = q.head; k < q.nodes.size(); ++k) close(q.nodes[k], currentPrice);
+                q.clear();
+                refreshLevels(id);
+            }
+            // --- BUY: positive sentiment opens a new position ---
+            else if (action == StrategyAction::Buy)
+            {
+                double toInvest = strategy.positionCash(balance);
+                balance -= toInvest;
+                ++totalTrades;
+                q.push_back({state.nextSeq++, toInvest / currentPrice, currentPrice, e.time,
+                             PriceLookupIndex::NO_PRICE});
+                state.stopLevel[id] = max(state.stopLevel[id], strategy.exit.stopPrice(currentPrice));
+                state.targetLevel[id] = min(state.targetLevel[id], strategy.exit.targetPrice(currentPrice));
+            }
+            continue;
+        }
+
+        // --- Price tick: expiries and stop-loss / take-profit of the ticker ---
+        if (q.empty()) continue;
+        double price = priceData.recordPrice(priceData.recordOffset(id) + e.ref);
+
+        // Positions expire in buy order, so only the front needs checking
+        bool closed = false;
+        while (!q.empty() && strategy.expiry(q.front().buyTime) <= e.time)
+        {
+            close(q.front(), price);
+            q.pop_front();
+            closed = true;
+        }
+
+        // Most ticks are between every open position's levels
+        if (price <= state.stopLevel[id] || price >= state.targetLevel[id])
+        {
+            size_t kept = q.head;
+            for (size_t k = q.head; k < q.nodes.size(); ++k)
+            {
+                const InvestmentNode& node = q.nodes[k];
+                if (price <= strategy.exit.stopPrice(node.buyPrice) ||
+                    price >= strategy.exit.targetPrice(node.buyPrice))
+                {
+                    close(node, price);
+                }
+                else
+                {
+                    q.nodes[kept++] = node;
+                }
+            }
+            q.nodes.resize(kept);
+            if (q.empty()) q.clear();
+            closed = true;
+        }
+        if (closed) refreshLevels(id);
+    }
+
+    return balance;
+}
+
+#endif // TIMELINE_BACKTEST_H
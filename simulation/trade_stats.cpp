@@ -0,0 +1,142 @@
+// Includes standard C++ libraries and project-specific headers
+#include "trade_stats.h"
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// === P2Quantile ===
+
+// Adds one observation
+void P2Quantile::add(double x)
+{
+    // The first five observations seed the markers
+    if (n < 5)
+    {
+        q[n++] = x;
+        if (n == 5)
+        {
+            sort(q, q + 5);
+            for (int i = 0; i < 5; ++i) pos[i] = i + 1;
+            want[0] = 1;
+            want[1] = 1 + 2 * p;
+            want[2] = 1 + 4 * p;
+            want[3] = 3 + 2 * p;
+            want[4] = 5;
+        }
+        return;
+    }
+
+    // Find the cell holding x, widening the extremes if needed
+    int k;
+    if (x < q[0])
+    {
+        q[0] = x;
+        k = 0;
+    }
+    else if (x >= q[4])
+    {
+        q[4] = x;
+        k = 3;
+    }
+    else
+    {
+        k = 0;
+        while (x >= q[k + 1]) ++k;
+    }
+
+    // Shift the markers above the cell and advance the desired positions
+    for (int i = k + 1; i < 5; ++i) pos[i] += 1;
+    const double step[5] = {0, p / 2, p, (1 + p) / 2, 1};
+    for (int i = 0; i < 5; ++i) want[i] += step[i];
+    ++n;
+
+    // Move the middle markers back towards their desired positions
+    for (int i = 1; i < 4; ++i)
+    {
+        double d = want[i] - pos[i];
+        if ((d >= 1 && pos[i + 1] - pos[i] > 1) || (d <= -1 && pos[i - 1] - pos[i] < -1))
+        {
+            double s = d > 0 ? 1.0 : -1.0;
+
+            // Piecewise-parabolic prediction, falling back to linear if it
+            // would leave the neighbouring markers' range
+            double parabolic = q[i] + s / (pos[i + 1] - pos[i - 1]) *
+                ((pos[i] - pos[i - 1] + s) * (q[i + 1] - q[i]) / (pos[i + 1] - pos[i]) +
+                 (pos[i + 1] - pos[i] - s) * (q[i] - q[i - 1]) / (pos[i] - pos[i - 1]));
+            if (q[i - 1] < parabolic && parabolic < q[i + 1])
+            {
+                q[i] = parabolic;
+            }
+            else
+            {
+                int j = i + static_cast<int>(s);
+                q[i] += s * (q[j] - q[i]) / (pos[j] - pos[i]);
+            }
+            pos[i] += s;
+        }
+    }
+}
+
+// Current estimate (0 when nothing has been added)
+double P2Quantile::value() const
+{
+    if (n == 0) return 0.0;
+    if (n >= 5) return q[2];
+
+    // Few observations: exact, picking the upper element for an even count.
+    // An insertion sort over at most five values; std::sort's 16-element
+    // threshold trips -Warray-bounds on the fixed-size buffer.
+    int m = min(n, 5);
+    double v[5];
+    for (int i = 0; i < m; ++i)
+    {
+        double x = q[i];
+        int j = i;
+        for (; j > 0 && v[j - 1] > x; --j) v[j] = v[j - 1];
+        v[j] = x;
+    }
+    return v[min(m - 1, static_cast<int>(p * m))];
+}
+
+// === TradeStats ===
+
+// Records one closed trade
+void TradeStats::add(double pnl)
+{
+    ++count;
+    sum += pnl;
+    if (pnl > 0)
+    {
+        ++wins;
+        bestWin = max(bestWin, pnl);
+        winMedian.add(pnl);
+    }
+    else
+    {
+        worstLoss = min(worstLoss, pnl);
+        lossMedian.add(pnl);
+    }
+
+    // Welford's update keeps the variance numerically stable
+    double delta = pnl - mean;
+    mean += delta / count;
+    m2 += delta * (pnl - mean);
+
+    // Drawdown of the realized equity curve
+    equity += pnl;
+    peak = max(peak, equity);
+    maxDrawdown = max(maxDrawdown, peak - equity);
+}
+
+// Standard deviation of trade P&L (0 with fewer than two trades)
+double TradeStats::volatility() const
+{
+    return count > 1 ? sqrt(m2 / (count - 1)) : 0.0;
+}
+
+// Mean trade P&L per unit of volatility (0 without volatility)
+double TradeStats::sharpe() const
+{
+    double vol = volatility();
+    return vol > 0 ? mean / vol : 0.0;
+}
@@ -0,0 +1,67 @@
+#ifndef TRADE_STATS_H
+#define TRADE_STATS_H
+
+// Includes standard C++ libraries
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// === Streaming trade statistics ===
+
+// P² estimator (Jain & Chlamtac, 1985) of one quantile of a stream, using five
+// markers instead of storing the values. Exact while fewer than five values
+// have been seen; after that the middle marker tracks the quantile.
+class P2Quantile
+{
+public:
+    explicit P2Quantile(double p = 0.5) : p(p) {}
+
+    // Adds one observation
+    void add(double x);
+
+    // Current estimate (0 when nothing has been added)
+    double value() const;
+
+    // Forgets every observation
+    void reset() { n = 0; }
+
+private:
+    double p;               // Quantile to track, in (0, 1)
+    int n = 0;              // Observations seen
+    double q[5] = {};       // Marker heights
+    double pos[5] = {};     // Marker positions (1-based ranks)
+    double want[5] = {};    // Desired marker positions
+};
+
+// Running statistics of the realized P&L of one strategy's trades, updated in
+// O(1) time and memory per trade. Trades with P&L > 0 count as wins, the rest
+// as losses.
+struct TradeStats
+{
+    int count = 0;              // Closed trades
+    int wins = 0;               // Trades with P&L > 0
+    double sum = 0.0;           // Total realized P&L
+    double bestWin = 0.0;       // Largest winning trade (0 if none)
+    double worstLoss = 0.0;     // Largest losing trade (0 if none)
+    double mean = 0.0;          // Mean trade P&L (Welford)
+    double m2 = 0.0;            // Sum of squared deviations from the mean (Welford)
+    double equity = 0.0;        // Cumulative realized P&L
+    double peak = 0.0;          // Highest cumulative realized P&L so far
+    double maxDrawdown = 0.0;   // Largest drop of cumulative P&L from a peak
+    P2Quantile winMedian;       // Median winning trade
+    P2Quantile lossMedian;      // Median losing trade
+
+    // Records one closed trade
+    void add(double pnl);
+
+    // Clears everything for a new run
+    void reset() { *this = TradeStats(); }
+
+    // Standard deviation of trade P&L (0 with fewer than two trades)
+    double volatility() const;
+
+    // Mean trade P&L per unit of volatility (0 without volatility)
+    double sharpe() const;
+};
+
+#endif // TRADE_STATS_H
@@ -0,0 +1,111 @@
+// Includes standard C++ libraries and project-specific headers
+#include "walk_forward.h"
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// === Fold construction ===
+
+// Cuts `eventCount` news events into folds
+vector<Fold> buildFolds(const WalkForwardConfig& cfg, size_t eventCount)
+{
+    size_t slices = cfg.kFold ? cfg.folds : cfg.folds + cfg.trainSlices;
+    if (cfg.folds == 0 || (cfg.kFold ? cfg.folds < 2 : cfg.trainSlices == 0) || eventCount < slices)
+    {
+        throw invalid_argument("Cannot split " + to_string(eventCount) + " news events into " +
+                               to_string(slices) + " walk-forward slices");
+    }
+
+    // Slice s covers events [s * n / slices, (s + 1) * n / slices)
+    auto edge = [&](size_t s){ return eventCount * s / slices; };
+
+    vector<Fold> folds;
+    for (size_t f = 0; f < cfg.folds; ++f)
+    {
+        Fold fold;
+        if (cfg.kFold)
+        {
+            fold.test = {edge(f), edge(f + 1)};
+            if (f > 0) fold.train.push_back({0, edge(f)});
+            if (f + 1 < slices) fold.train.push_back({edge(f + 1), eventCount});
+        }
+        else
+        {
+            fold.train.push_back({edge(f), edge(f + cfg.trainSlices)});
+            fold.test = {edge(f + cfg.trainSlices), edge(f + cfg.trainSlices + 1)};
+        }
+        folds.push_back(fold);
+    }
+    return folds;
+}
+
+// === Fold evaluation ===
+
+// Optimizes the grid on one fold's train ranges, then runs the winner on the test range
+static FoldResult runFold(const Fold& fold, const vector<GridPoint>& grid,
+                          const PriceLookupIndex& lookup, unsigned threads, size_t batchSize)
+{
+    SweepOptions options;
+    options.threads = threads;
+    options.batchSize = batchSize;
+
+    // Each train range is simulated from a fresh $10000 portfolio; profits add up
+    vector<TrainScore> scores(grid.size());
+    for (size_t i = 0; i < grid.size(); ++i) scores[i] = {i, grid[i], 0.0, 0, 0};
+    for (auto const& range : fold.train)
+    {
+        options.events = range;
+        for (auto const& r : runSweep(grid, lookup, options))
+        {
+            scores[r.index].profit += r.result - 10000.0;
+            scores[r.index].trades += r.trades;
+            scores[r.index].profitable += r.profitable;
+        }
+    }
+
+    // Earliest grid point wins ties, as in the full sweep
+    FoldResult out;
+    out.fold = fold;
+    out.train = scores.front();
+    for (auto const& s : scores)
+    {
+        if (s.profit > out.train.profit) out.train = s;
+    }
+
+    options.events = fold.test;
+    options.threads = 1;
+    out.test = runSweep({out.train.params}, lookup, options).front();
+    out.test.index = out.train.index;
+    return out;
+}
+
+// Runs every fold; folds are claimed by up to `threads` workers and each fold's
+// sweep gets an equal share of the threads
+vector<FoldResult> runWalkForward(const vector<Fold>& folds, const vector<GridPoint>& grid,
+                                  const PriceLookupIndex& lookup, unsigned threads, size_t batchSize)
+{
+    unsigned foldWorkers = max(1u, min<unsigned>(threads, folds.size()));
+    unsigned sweepThreads = max(1u, threads / foldWorkers);
+
+    vector<FoldResult> results(folds.size());
+    atomic<size_t> nextFold{0};
+    auto worker = [&]()
+    {
+        for (size_t f = nextFold++; f < folds.size(); f = nextFold++)
+        {
+            results[f] = runFold(folds[f], grid, lookup, sweepThreads, batchSize);
+        }
+    };
+
+    if (foldWorkers == 1)
+    {
+        worker();
+    }
+    else
+    {
+        vector<thread> pool;
+        for (unsigned w = 0; w < foldWorkers; ++w) pool.emplace_back(worker);
+        for (auto& t : pool) t.join();
+    }
+    return results;
+}
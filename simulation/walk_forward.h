@@ -0,0 +1,60 @@
+#ifndef WALK_FORWARD_H
+#define WALK_FORWARD_H
+
+// Includes standard C++ libraries and project-specific headers
+#include <bits/stdc++.h>
+#include "sweep.h"
+
+using namespace std;
+
+// === Walk-forward / k-fold validation ===
+
+// How the news timeline is cut into train/test folds. The timeline is split
+// into equal slices of news events.
+//   walk-forward: folds + trainSlices slices; fold f trains on the trainSlices
+//                 slices starting at f and tests on the slice right after them
+//   k-fold:       folds slices; fold f tests on slice f and trains on the rest
+struct WalkForwardConfig
+{
+    bool kFold = false;
+    size_t folds = 4;
+    size_t trainSlices = 3;
+};
+
+// Event ranges of one fold. Training may span two disjoint ranges (k-fold).
+struct Fold
+{
+    vector<EventRange> train;
+    EventRange test;
+};
+
+// In-sample performance of one grid point, summed over the train ranges
+struct TrainScore
+{
+    size_t index;           // Position of the grid point in the grid
+    GridPoint params;       // Strategy parameters used
+    double profit;          // Final balance minus starting cash, summed over ranges
+    int trades;             // Number of buys
+    int profitable;         // Number of profitable sells
+};
+
+// Outcome of one fold: the strategy fitted on the train ranges and its
+// out-of-sample run on the test range
+struct FoldResult
+{
+    Fold fold;
+    TrainScore train;       // Best grid point on the train ranges
+    SweepResult test;       // Same parameters simulated on the test range
+};
+
+// Cuts `eventCount` news events into folds; throws invalid_argument when the
+// timeline is too short for the requested number of slices
+vector<Fold> buildFolds(const WalkForwardConfig& cfg, size_t eventCount);
+
+// Optimizes the grid on every fold's train ranges and evaluates the winner on
+// its test range. Folds run concurrently on up to `threads` workers and share
+// the read-only dataset and lookup index; results are returned in fold order.
+vector<FoldResult> runWalkForward(const vector<Fold>& folds, const vector<GridPoint>& grid,
+                                  const PriceLookupIndex& lookup, unsigned threads, size_t batchSize);
+
+#endif // WALK_FORWARD_H
@@ -0,0 +1,219 @@
+// Includes standard C++ libraries and project-specific headers
+#include "../../include/news_parser.h"
+#include "../../include/json_reader.h"
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace chrono;
+
+// === Benchmark settings ===
+
+// Shape of the synthetic MarketAux response and of the timed workload
+struct BenchmarkOptions
+{
+    size_t articles = 100;          // Articles in the response
+    size_t entities = 4;            // Entities per article, each with one highlight
+    size_t similar = 2;             // Nested "similar" articles per article
+    size_t iterations = 2000;       // Times each parser reads the response
+    uint64_t seed = 1;
+};
+
+// === Helpers ===
+
+// Seconds elapsed since `start`
+static double secondsSince(steady_clock::time_point start)
+{
+    return duration<double>(steady_clock::now() - start).count();
+}
+
+// Prints one aligned "label: value unit" report line
+static void report(const string& label, double value, const string& unit, int decimals = 3)
+{
+    cout << "  " << left << setw(28) << label + ":" << right << setw(16) << fixed << setprecision(decimals)
+         << value << ' ' << unit << defaultfloat << endl;
+}
+
+// === Synthetic response ===
+
+// Writes a response shaped like marketaux_fetcher.py output (json.dumps with indent=4).
+// Titles carry escaped quotes and \u escapes, and every article has entities
+// and nested "similar" articles with their own title/url/published_at.
+static string syntheticResponse(const BenchmarkOptions& options)
+{
+    mt19937_64 rng(options.seed);
+    auto pick = [&](size_t n) { return size_t(rng() % n); };
+    const char* words[] = {"Shares", "rally", "after", "earnings", "beat", "guidance", "cut", "Caf\\u00e9",
+                           "\\\"record\\\"", "quarter", "merger", "talks", "stall", "analysts", "upgrade"};
+
+    auto sentence = [&](size_t length)
+    {
+        string s;
+        for (size_t i = 0; i < length; ++i) s += (i ? " " : "") + string(words[pick(size(words))]);
+        return s;
+    };
+
+    ostringstream out;
+    function<void(const string&, size_t, bool)> article = [&](const string& indent, size_t id, bool nested)
+    {
+        string in = indent + "    ";
+        out << indent << "{\n"
+            << in << "\"uuid\": \"" << hex << rng() << dec << "\",\n"
+            << in << "\"title\": \"" << sentence(8 + pick(8)) << "\",\n"
+            << in << "\"description\": \"" << sentence(20) << "\",\n";
+        if (!nested)
+        {
+            out << in << "\"keywords\": \"\",\n"
+                << in << "\"snippet\": \"" << sentence(40) << "\",\n";
+        }
+        out << in << "\"url\": \"https://news" << pick(50) << ".example.com/" << (nested ? "similar/" : "story/") << id << "\",\n"
+            << in << "\"image_url\": \"https://cdn.example.com/" << id << ".jpg\",\n"
+            << in << "\"language\": \"en\",\n"
+            << in << "\"published_at\": \"2025-03-28T15:" << setw(2) << setfill('0') << pick(60) << setfill(' ')
+            << ":00.000000Z\",\n"
+            << in << "\"source\": \"news" << pick(50) << ".example.com\",\n"
+            << in << "\"relevance_score\": null";
+        if (!nested)
+        {
+            out << ",\n" << in << "\"entities\": [";
+            for (size_t e = 0; e < options.entities; ++e)
+            {
+                string en = in + "        ";
+                out << (e ? ",\n" : "\n") << in << "    {\n"
+                    << en << "\"symbol\": \"TK" << pick(1000) << "\",\n"
+                    << en << "\"name\": \"" << sentence(2) << " Inc.\",\n"
+                    << en << "\"exchange\": null,\n"
+                    << en << "\"country\": \"us\",\n"
+                    << en << "\"type\": \"equity\",\n"
+                    << en << "\"match_score\": " << (rng() % 10000) / 100.0 << ",\n"
+                    << en << "\"sentiment_score\": " << (int(rng() % 2001) - 1000) / 1000.0 << ",\n"
+                    << en << "\"highlights\": [\n"
+                    << en << "    {\n"
+                    << en << "        \"highlight\": \"" << sentence(12) << "\",\n"
+                    << en << "        \"sentiment\": 0.4215,\n"
+                    << en << "        \"highlighted_in\": \"title\"\n"
+                    << en << "    }\n"
+                    << en << "]\n"
+                    << in << "    }";
+            }
+            out << "\n" << in << "],\n" << in << "\"similar\": [";
+            for (size_t s = 0; s < options.similar; ++s)
+            {
+                out << (s ? ",\n" : "\n");
+                article(in + "    ", id * 100 + s, true);
+            }
+            out << "\n" << in << "]";
+        }
+        out << "\n" << indent << "}";
+    };
+
+    out << "{\n    \"meta\": {\n        \"found\": " << options.articles << ",\n        \"returned\": " << options.articles
+        << ",\n        \"limit\": " << options.articles << ",\n        \"page\": 1\n    },\n    \"data\": [";
+    for (size_t a = 0; a < options.articles; ++a)
+    {
+        out << (a ? ",\n" : "\n");
+        article("        ", a, false);
+    }
+    out << "\n    ]\n}";
+    return out.str();
+}
+
+// === Find-based extraction ===
+
+// The string::find extraction extractNewsFromResponse() used before the JSON
+// reader, kept for comparison. It takes the first "url" and "published_at"
+// after every "title" key at any depth and does not decode escapes.
+static vector<NewsItem> findBasedExtract(const string& response)
+{
+    vector<NewsItem> items;
+    size_t pos = 0;
+    while (true)
+    {
+        pos = response.find("\"title\":", pos);
+        if (pos == string::npos) break;
+
+        NewsItem item;
+        size_t start = response.find("\"", pos + 8) + 1;
+        size_t end = response.find("\"", start);
+        item.title = response.substr(start, end - start);
+        pos = end;
+
+        pos = response.find("\"url\":", pos);
+        if (pos == string::npos) break;
+        start = response.find("\"", pos + 6) + 1;
+        end = response.find("\"", start);
+        item.url = response.substr(start, end - start);
+        pos = end;
+
+        pos = response.find("\"published_at\":", pos);
+        if (pos == string::npos) break;
+        start = response.find("\"", pos + 16) + 1;
+        end = response.find("\"", start);
+        item.publishedAt = response.substr(start, end - start);
+        pos = end;
+
+        items.push_back(move(item));
+    }
+    return items;
+}
+
+// Usage: json_benchmark [--articles N] [--entities N] [--similar N] [--iterations N] [--seed N]
+// Generates a synthetic MarketAux response, then times the find-based
+// extraction, parseNewsResponse(), and a bare pass of the JSON reader over it.
+int main(int argc, char* argv[])
+{
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; ++i)
+    {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--articles" && hasValue) options.articles = stoul(argv[++i]);
+        else if (arg == "--entities" && hasValue) options.entities = stoul(argv[++i]);
+        else if (arg == "--similar" && hasValue) options.similar = stoul(argv[++i]);
+        else if (arg == "--iterations" && hasValue) options.iterations = max<size_t>(stoul(argv[++i]), 1);
+        else if (arg == "--seed" && hasValue) options.seed = stoull(argv[++i]);
+        else
+        {
+            cerr << "Usage: " << argv[0]
+                 << " [--articles N] [--entities N] [--similar N] [--iterations N] [--seed N]" << endl;
+            return 1;
+        }
+    }
+
+    string response = syntheticResponse(options);
+    double mib = response.size() / (1024.0 * 1024.0);
+    cout << "Synthetic response: " << options.articles << " articles, " << options.entities << " entities and "
+         << options.similar << " similar articles each, " << response.size() << " bytes" << endl;
+
+    // Each run reports time per response, throughput, and how many articles it found
+    auto run = [&](const string& name, auto&& parse)
+    {
+        size_t found = parse().size();
+        auto t0 = steady_clock::now();
+        for (size_t i = 0; i < options.iterations; ++i)
+        {
+            found = parse().size();
+        }
+        double seconds = secondsSince(t0);
+        cout << name << ":" << endl;
+        report("time per response", seconds / options.iterations * 1e6, "us", 1);
+        report("throughput", mib * options.iterations / seconds, "MiB/s", 1);
+        report("articles found", double(found), "", 0);
+    };
+
+    run("find-based", [&]{ return findBasedExtract(response); });
+    run("JSON reader", [&]{ return parseNewsResponse(response); });
+
+    // Tokenizing alone, without building NewsItems
+    size_t tokens = 0;
+    auto t0 = steady_clock::now();
+    for (size_t i = 0; i < options.iterations; ++i)
+    {
+        JsonReader reader(response);
+        while (reader.next() != JsonToken::End) ++tokens;
+    }
+    double seconds = secondsSince(t0);
+    cout << "Tokenize only:" << endl;
+    report("throughput", mib * options.iterations / seconds, "MiB/s", 1);
+    report("tokens/s", tokens / seconds, "", 0);
+    return 0;
+}
@@ -0,0 +1,208 @@
+// Includes platform process/pipe APIs, standard C++ libraries and project-specific headers
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#endif
+#include "../include/child_process.h"
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace chrono;
+
+#ifdef _WIN32
+// Quotes one argument so the C runtime of the child parses it back unchanged
+// (backslashes only escape a following quote)
+static string quoteArgument(const string& argument)
+{
+    string out = "\"";
+    size_t slashes = 0;
+    for (char c : argument)
+    {
+        if (c == '\\')
+        {
+            ++slashes;
+            continue;
+        }
+        out.append(c == '"' ? slashes * 2 + 1 : slashes, '\\');
+        out += c;
+        slashes = 0;
+    }
+    out.append(slashes * 2, '\\');
+    return out + "\"";
+}
+#endif
+
+// Starts argv[0] with argv as its arguments, without a shell
+ChildProcess spawnProcess(const vector<string>& argv, bool mergeStderr, const string& name)
+{
+    ChildProcess child;
+#ifdef _WIN32
+    // Inheritable pipes for the child's stdin and stdout
+    SECURITY_ATTRIBUTES sa{sizeof(SECURITY_ATTRIBUTES), nullptr, TRUE};
+    HANDLE childIn = nullptr, childOut = nullptr, writeEnd = nullptr, readEnd = nullptr;
+    if (!CreatePipe(&childIn, &writeEnd, &sa, 0))
+    {
+        throw runtime_error("Failed to create pipe to " + name);
+    }
+    if (!CreatePipe(&readEnd, &childOut, &sa, 0))
+    {
+        CloseHandle(childIn);
+        CloseHandle(writeEnd);
+        throw runtime_error("Failed to create pipe from " + name);
+    }
+
+    // Our ends must not leak into the child, or it never sees end of input
+    SetHandleInformation(writeEnd, HANDLE_FLAG_INHERIT, 0);
+    SetHandleInformation(readEnd, HANDLE_FLAG_INHERIT, 0);
+
+    STARTUPINFOA si{};
+    si.cb = sizeof(si);
+    si.dwFlags = STARTF_USESTDHANDLES;
+    si.hStdInput = childIn;
+    si.hStdOutput = childOut;
+    si.hStdError = mergeStderr ? childOut : GetStdHandle(STD_ERROR_HANDLE);
+    PROCESS_INFORMATION pi{};
+
+    string command;
+    for (const string& argument : argv) command += (command.empty() ? "" : " ") + quoteArgument(argument);
+    BOOL created = CreateProcessA(nullptr, &command[0], nullptr, nullptr, TRUE, 0,
+                                  nullptr, nullptr, &si, &pi);
+    CloseHandle(childIn);
+    CloseHandle(childOut);
+    if (!created)
+    {
+        CloseHandle(writeEnd);
+        CloseHandle(readEnd);
+        throw runtime_error("Failed to start " + name + " (error " + to_string(GetLastError()) + ")");
+    }
+    CloseHandle(pi.hThread);
+    child.process = pi.hProcess;
+    child.input = writeEnd;
+    child.output = readEnd;
+#else
+    // A child that died must fail the write, not kill the application
+    signal(SIGPIPE, SIG_IGN);
+
+    int inPipe[2], outPipe[2];
+    if (pipe(inPipe) != 0)
+    {
+        throw runtime_error("Failed to create pipe to " + name);
+    }
+    if (pipe(outPipe) != 0)
+    {
+        close(inPipe[0]);
+        close(inPipe[1]);
+        throw runtime_error("Failed to create pipe from " + name);
+    }
+
+    // Our ends must not leak into other children, or the child never sees end of input
+    fcntl(inPipe[1], F_SETFD, FD_CLOEXEC);
+    fcntl(outPipe[0], F_SETFD, FD_CLOEXEC);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, inPipe[0], STDIN_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, outPipe[1], STDOUT_FILENO);
+    if (mergeStderr) posix_spawn_file_actions_adddup2(&actions, outPipe[1], STDERR_FILENO);
+    posix_spawn_file_actions_addclose(&actions, inPipe[0]);
+    posix_spawn_file_actions_addclose(&actions, outPipe[1]);
+
+    vector<char*> args;
+    for (const string& argument : argv) args.push_back(const_cast<char*>(argument.c_str()));
+    args.push_back(nullptr);
+    pid_t pid;
+    int error = posix_spawnp(&pid, args[0], &actions, nullptr, args.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(inPipe[0]);
+    close(outPipe[1]);
+    if (error != 0)
+    {
+        close(inPipe[1]);
+        close(outPipe[0]);
+        throw runtime_error("Failed to start " + name + ": " + string(strerror(error)));
+    }
+    child.process = pid;
+    child.input = inPipe[1];
+    child.output = outPipe[0];
+#endif
+    return child;
+}
+
+// Runs argv to completion and returns its output; kills it after timeoutSeconds
+string runProcess(const vector<string>& argv, int timeoutSeconds, int& exitCode, const string& name,
+                  bool mergeStderr)
+{
+    ChildProcess child = spawnProcess(argv, mergeStderr, name);
+    string output;
+    char buffer[4096];
+    bool timedOut = false;
+
+#ifdef _WIN32
+    // Nothing to send: closing stdin lets the child see end of input
+    CloseHandle(child.input);
+
+    // The child's exit closes its end of the pipe, which ends the read loop below
+    thread watchdog([&]
+    {
+        if (WaitForSingleObject(child.process, DWORD(timeoutSeconds) * 1000) == WAIT_TIMEOUT)
+        {
+            timedOut = true;
+            TerminateProcess(child.process, 1);
+        }
+    });
+    DWORD got;
+    while (ReadFile(child.output, buffer, sizeof(buffer), &got, nullptr) && got > 0)
+    {
+        output.append(buffer, got);
+    }
+    watchdog.join();
+    CloseHandle(child.output);
+
+    DWORD code = 1;
+    GetExitCodeProcess(child.process, &code);
+    CloseHandle(child.process);
+    exitCode = static_cast<int>(code);
+#else
+    // Nothing to send: closing stdin lets the child see end of input
+    close(child.input);
+
+    auto deadline = steady_clock::now() + seconds(timeoutSeconds);
+    while (true)
+    {
+        auto remaining = duration_cast<milliseconds>(deadline - steady_clock::now()).count();
+        pollfd ready{child.output, POLLIN, 0};
+        int events = remaining > 0 ? poll(&ready, 1, static_cast<int>(remaining)) : 0;
+        if (events < 0 && errno == EINTR) continue;
+        if (events <= 0)
+        {
+            // Out of time (or poll failed): stop the child instead of waiting on it
+            timedOut = events == 0;
+            kill(child.process, SIGKILL);
+            break;
+        }
+
+        ssize_t got = read(child.output, buffer, sizeof(buffer));
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) break;
+        output.append(buffer, got);
+    }
+    close(child.output);
+
+    int status = 0;
+    while (waitpid(child.process, &status, 0) < 0 && errno == EINTR) {}
+    exitCode = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+#endif
+
+    if (timedOut)
+    {
+        throw runtime_error(name + " was killed after running for " + to_string(timeoutSeconds) + " seconds");
+    }
+    return output;
+}
@@ -0,0 +1,373 @@
+// Includes standard C++ libraries and project-specific headers
+#include "../include/company_index.h"
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// === Vector kernels ===
+
+// Dot product of two float vectors. Sixteen independent partial sums keep the
+// loop vectorizable (two AVX2 registers with -march=native) without -ffast-math.
+static float dotFloat(const float* __restrict a, const float* __restrict b, size_t n)
+{
+    float acc[16] = {};
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        for (int l = 0; l < 16; ++l) acc[l] += a[i + l] * b[i + l];
+    }
+    float sum = 0.0f;
+    for (int l = 0; l < 16; ++l) sum += acc[l];
+    for (; i < n; ++i) sum += a[i] * b[i];
+    return sum;
+}
+
+// Dot product of two int8 vectors (exact in int32 for any realistic dimension)
+static int32_t dotInt8(const int8_t* __restrict a, const int8_t* __restrict b, size_t n)
+{
+    int32_t sum = 0;
+    for (size_t i = 0; i < n; ++i) sum += int32_t(a[i]) * int32_t(b[i]);
+    return sum;
+}
+
+// Scales a vector to unit length (zero vectors stay zero)
+static void normalize(float* v, size_t n)
+{
+    double norm = 0.0;
+    for (size_t i = 0; i < n; ++i) norm += double(v[i]) * v[i];
+    if (norm == 0.0) return;
+    float inv = float(1.0 / sqrt(norm));
+    for (size_t i = 0; i < n; ++i) v[i] *= inv;
+}
+
+// Rounds a vector to int8 with one symmetric scale; returns the scale back to floats
+static float quantize(const float* v, int8_t* out, size_t n)
+{
+    float maxAbs = 0.0f;
+    for (size_t i = 0; i < n; ++i) maxAbs = max(maxAbs, fabs(v[i]));
+    if (maxAbs == 0.0f)
+    {
+        fill(out, out + n, int8_t(0));
+        return 0.0f;
+    }
+    float toInt = 127.0f / maxAbs;
+    for (size_t i = 0; i < n; ++i) out[i] = int8_t(lrintf(v[i] * toInt));
+    return maxAbs / 127.0f;
+}
+
+// Parses "exact", "int8" or "hnsw"
+CompanyIndexMode parseCompanyIndexMode(const string& name)
+{
+    if (name == "exact") return CompanyIndexMode::Exact;
+    if (name == "int8") return CompanyIndexMode::Int8;
+    if (name == "hnsw") return CompanyIndexMode::Hnsw;
+    throw invalid_argument("Unknown company index mode: " + name + " (expected exact, int8 or hnsw)");
+}
+
+// === CompanyIndex ===
+
+// Loads a company embedding file written by company_exporter.py
+void CompanyIndex::load(const string& path)
+{
+    ifstream in(path, ios::binary);
+    if (!in)
+    {
+        throw runtime_error("Failed to open company embeddings: " + path);
+    }
+
+    // Header: magic, version, count, dimension, reserved
+    char magic[8];
+    uint32_t header[4];
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!in || memcmp(magic, "NDTEMBED", 8) != 0 || header[0] != 1)
+    {
+        throw runtime_error("Not a company embedding file (version 1): " + path);
+    }
+    size_t count = header[1];
+    dim = header[2];
+
+    // Names and tickers, each a length-prefixed UTF-8 string
+    auto readString = [&]()
+    {
+        uint32_t length = 0;
+        in.read(reinterpret_cast<char*>(&length), sizeof(length));
+        string s(length, '\0');
+        if (length) in.read(&s[0], length);
+        return s;
+    };
+    names.resize(count);
+    tickers.resize(count);
+    for (size_t i = 0; i < count && in; ++i)
+    {
+        names[i] = readString();
+        tickers[i] = readString();
+    }
+
+    // The embedding matrix, one row per company
+    vectors.resize(count * dim);
+    in.read(reinterpret_cast<char*>(vectors.data()), streamsize(vectors.size() * sizeof(float)));
+    if (!in)
+    {
+        throw runtime_error("Company embedding file is truncated: " + path);
+    }
+
+    for (size_t i = 0; i < count; ++i) normalize(&vectors[i * dim], dim);
+
+    // Search structures of the previous file no longer apply
+    mode = CompanyIndexMode::Exact;
+    quantized.clear();
+    scales.clear();
+    links.clear();
+    topLevel = -1;
+}
+
+// Prepares the search structures of a mode: int8 rows or the HNSW graph
+void CompanyIndex::build(CompanyIndexMode searchMode)
+{
+    mode = searchMode;
+    size_t count = size();
+
+    if (mode == CompanyIndexMode::Int8)
+    {
+        quantized.resize(count * dim);
+        scales.resize(count);
+        for (size_t i = 0; i < count; ++i) scales[i] = quantize(row(i), &quantized[i * dim], dim);
+    }
+    else if (mode == CompanyIndexMode::Hnsw)
+    {
+        // Node levels are drawn from a fixed seed, so the graph is the same every start
+        mt19937_64 rng(0x5eed);
+        uniform_real_distribution<double> uniform(0.0, 1.0);
+        double levelScale = 1.0 / log(double(max<size_t>(graphDegree, 2)));
+
+        links.assign(count, {});
+        topLevel = -1;
+        vector<uint32_t> visited(count, 0);
+        uint32_t mark = 0;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            int level = int(-log(1.0 - uniform(rng)) * levelScale);
+            insertNode(i, level, visited, mark);
+        }
+    }
+}
+
+// Up to k most similar companies to a query embedding, best first
+vector<CompanyMatch> CompanyIndex::search(const float* query, size_t k) const
+{
+    size_t count = size();
+    if (count == 0 || k == 0) return {};
+
+    vector<float> q(query, query + dim);
+    normalize(q.data(), dim);
+
+    vector<uint32_t> companies;
+    if (mode == CompanyIndexMode::Int8)
+    {
+        // The int8 order is close to exact; re-ranking a few times k repairs it
+        companies = scanInt8(q.data(), max<size_t>(8 * k, 32));
+    }
+    else if (mode == CompanyIndexMode::Hnsw && topLevel >= 0)
+    {
+        // Greedy descent through the upper layers, then a wide search on layer 0
+        uint32_t current = entryPoint;
+        float currentDistance = 1.0f - dotFloat(q.data(), row(current), dim);
+        for (int level = topLevel; level > 0; --level)
+        {
+            for (bool moved = true; moved; )
+            {
+                moved = false;
+                for (uint32_t n : links[current][level])
+                {
+                    float d = 1.0f - dotFloat(q.data(), row(n), dim);
+                    if (d < currentDistance)
+                    {
+                        current = n;
+                        currentDistance = d;
+                        moved = true;
+                    }
+                }
+            }
+        }
+        vector<uint32_t> visited(count, 0);
+        for (const Candidate& c : searchLayer(q.data(), current, max(searchBreadth, k), 0, visited, 1))
+        {
+            companies.push_back(c.second);
+        }
+    }
+    else
+    {
+        companies.resize(count);
+        iota(companies.begin(), companies.end(), 0u);
+    }
+    return rerank(q.data(), companies, k);
+}
+
+// Exact similarity of a normalized query to a set of companies, best k first
+vector<CompanyMatch> CompanyIndex::rerank(const float* query, vector<uint32_t>& companies, size_t k) const
+{
+    vector<CompanyMatch> matches;
+    matches.reserve(companies.size());
+    for (uint32_t c : companies)
+    {
+        float cosine = dotFloat(query, row(c), dim);
+        matches.push_back({c, min(1.0f, max(0.0f, (1.0f + cosine) / 2.0f))});
+    }
+
+    // Ties go to the lower row, so every mode agrees on equal scores
+    k = min(k, matches.size());
+    partial_sort(matches.begin(), matches.begin() + k, matches.end(),
+        [](const CompanyMatch& a, const CompanyMatch& b)
+        {
+            if (a.similarity != b.similarity) return a.similarity > b.similarity;
+            return a.company < b.company;
+        });
+    matches.resize(k);
+    return matches;
+}
+
+// Scans int8 rows for the closest candidates
+vector<uint32_t> CompanyIndex::scanInt8(const float* query, size_t count) const
+{
+    vector<int8_t> q(dim);
+    quantize(query, q.data(), dim);
+
+    // The query's own scale is the same for every row and does not change the order
+    vector<pair<float, uint32_t>> scored(size());
+    for (uint32_t i = 0; i < size(); ++i)
+    {
+        scored[i] = {float(dotInt8(q.data(), &quantized[size_t(i) * dim], dim)) * scales[i], i};
+    }
+
+    count = min(count, scored.size());
+    nth_element(scored.begin(), scored.begin() + (count - 1), scored.end(), greater<pair<float, uint32_t>>());
+    vector<uint32_t> companies(count);
+    for (size_t i = 0; i < count; ++i) companies[i] = scored[i].second;
+    return companies;
+}
+
+// Closest `breadth` nodes of one HNSW layer to a query, nearest first
+vector<CompanyIndex::Candidate> CompanyIndex::searchLayer(const float* query, uint32_t entry, size_t breadth,
+                                                          int level, vector<uint32_t>& visited, uint32_t mark) const
+{
+    priority_queue<Candidate, vector<Candidate>, greater<Candidate>> frontier;   // Nearest first
+    priority_queue<Candidate> best;                                               // Farthest first
+
+    Candidate start{1.0f - dotFloat(query, row(entry), dim), entry};
+    visited[entry] = mark;
+    frontier.push(start);
+    best.push(start);
+
+    while (!frontier.empty())
+    {
+        Candidate c = frontier.top();
+        if (best.size() >= breadth && c.first > best.top().first) break;
+        frontier.pop();
+
+        for (uint32_t n : links[c.second][level])
+        {
+            if (visited[n] == mark) continue;
+            visited[n] = mark;
+            float d = 1.0f - dotFloat(query, row(n), dim);
+            if (best.size() < breadth || d < best.top().first)
+            {
+                frontier.push({d, n});
+                best.push({d, n});
+                if (best.size() > breadth) best.pop();
+            }
+        }
+    }
+
+    vector<Candidate> result(best.size());
+    for (size_t i = result.size(); i-- > 0; best.pop()) result[i] = best.top();
+    return result;
+}
+
+// Picks up to `count` links from candidates sorted nearest first. A candidate
+// closer to an already picked link than to the node is skipped, so links
+// spread out instead of all pointing into the nearest cluster; skipped
+// candidates fill any places left.
+vector<uint32_t> CompanyIndex::selectNeighbours(const vector<Candidate>& candidates, size_t count) const
+{
+    vector<uint32_t> picked;
+    vector<uint32_t> skipped;
+    for (const Candidate& c : candidates)
+    {
+        if (picked.size() == count) break;
+        bool diverse = true;
+        for (uint32_t p : picked)
+        {
+            if (1.0f - dotFloat(row(c.second), row(p), dim) < c.first)
+            {
+                diverse = false;
+                break;
+            }
+        }
+        (diverse ? picked : skipped).push_back(c.second);
+    }
+    for (size_t k = 0; k < skipped.size() && picked.size() < count; ++k) picked.push_back(skipped[k]);
+    return picked;
+}
+
+// Inserts company i into the HNSW graph
+void CompanyIndex::insertNode(uint32_t i, int level, vector<uint32_t>& visited, uint32_t& mark)
+{
+    links[i].assign(level + 1, {});
+    if (topLevel < 0)
+    {
+        entryPoint = i;
+        topLevel = level;
+        return;
+    }
+
+    // Greedy descent to the node's top layer
+    const float* v = row(i);
+    uint32_t current = entryPoint;
+    float currentDistance = 1.0f - dotFloat(v, row(current), dim);
+    for (int l = topLevel; l > level; --l)
+    {
+        for (bool moved = true; moved; )
+        {
+            moved = false;
+            for (uint32_t n : links[current][l])
+            {
+                float d = 1.0f - dotFloat(v, row(n), dim);
+                if (d < currentDistance)
+                {
+                    current = n;
+                    currentDistance = d;
+                    moved = true;
+                }
+            }
+        }
+    }
+
+    // Link to the nearest nodes of every layer the node is on
+    for (int l = min(level, topLevel); l >= 0; --l)
+    {
+        vector<Candidate> candidates = searchLayer(v, current, buildBreadth, l, visited, ++mark);
+        size_t maxLinks = l == 0 ? 2 * graphDegree : graphDegree;
+
+        links[i][l] = selectNeighbours(candidates, graphDegree);
+
+        // Back links; a full neighbour re-selects among its links and the new node
+        for (uint32_t n : links[i][l])
+        {
+            auto& theirs = links[n][l];
+            theirs.push_back(i);
+            if (theirs.size() <= maxLinks) continue;
+            vector<Candidate> ranked;
+            for (uint32_t m : theirs) ranked.push_back({1.0f - dotFloat(row(n), row(m), dim), m});
+            sort(ranked.begin(), ranked.end());
+            theirs = selectNeighbours(ranked, maxLinks);
+        }
+        current = candidates.front().second;
+    }
+
+    if (level > topLevel)
+    {
+        entryPoint = i;
+        topLevel = level;
+    }
+}
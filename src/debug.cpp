@@ -2,6 +2,7 @@
 #include "../include/debug.h"
 #include "../include/utils.h"
 #include "../include/globals.h"
+#include "../include/news_processing.h"
 #include "bits/stdc++.h"
 
 using namespace std;
@@ -12,16 +13,30 @@ void startDebugMonitor()
 {
     while(true)
     {
-        {
-            // Safely lock and report the current number of news items waiting to be processed
-            lock_guard<mutex> lock(newsQueueMutex);
-            safeCout("[DEBUG] ", "Current newsQueue size: " + to_string(newsQueue.size()) + "\n\n");
-        }
+        // Report the current number of news items waiting to be processed, and any dropped on overflow
+        safeCout("[DEBUG] ", "Current newsQueue size: " + to_string(newsQueue.size()) + "/" + to_string(newsQueue.capacity())
+                             + " (" + to_string(newsQueue.dropped()) + " dropped)\n\n");
+
+        // Report the number of processed company status entries
+        safeCout("[DEBUG] ", "Current companyStatusQueue size: " + to_string(companyStatusQueue.size()) + "/"
+                             + to_string(companyStatusQueue.capacity())
+                             + " (" + to_string(companyStatusQueue.dropped()) + " dropped)\n\n");
+
+        // Report duplicate URLs skipped and URLs forgotten early because the seen-URL set was full
+        safeCout("[DEBUG] ", "Seen URLs: " + to_string(seenUrls.duplicates()) + " duplicates skipped, "
+                             + to_string(seenUrls.evictions()) + " evicted (capacity " + to_string(seenUrls.capacity()) + ")\n\n");
 
         {
-            // Safely lock and report the number of processed company status entries
-            lock_guard<mutex> lock(companyStatusQueueMutex);
-            safeCout("[DEBUG] ", "Current companyStatusQueue size: " + to_string(companyStatusQueue.size()) + "\n\n");
+            // Report average time per article of each processing stage; the article time is
+            // below the sum of the stages because company matching and sentiment run side by side
+            ProcessingStats stats = stageStatistics();
+            if(stats.articles > 0)
+            {
+                auto averageMs = [&](uint64_t micros) { return to_string(micros / stats.articles / 1000) + " ms"; };
+                safeCout("[DEBUG] ", "Processed " + to_string(stats.articles) + " articles, average per article: company "
+                                     + averageMs(stats.companyMicros) + ", sentiment " + averageMs(stats.sentimentMicros)
+                                     + ", total " + averageMs(stats.articleMicros) + "\n\n");
+            }
         }
 
         // Wait for 10 seconds before logging again to avoid flooding the output
@@ -10,18 +10,14 @@ double balance = 10000;
 // Global ofstream to write logs to file
 ofstream logFile;
 
-// Mutexes to protect global queues
-mutex newsQueueMutex;
-mutex companyStatusQueueMutex;
-
 // Global queue to store parsed news items
-queue<NewsItem> newsQueue;
+BoundedQueue<NewsItem> newsQueue;
 
 // Global set to track already-seen URLs
-set<string> seenUrls;
+UrlDedupSet seenUrls;
 
 // Global queue to store company sentiment analysis results
-queue<CompanyStatus> companyStatusQueue;
+BoundedQueue<CompanyStatus> companyStatusQueue;
 
 // Config object to hold configuration settings, loaded from a configuration file
 Config cfg;
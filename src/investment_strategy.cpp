@@ -3,6 +3,7 @@
 #include "../include/investment_strategy.h"
 #include "../include/utils.h"
 #include "../include/globals.h"
+#include "../include/strategy_engine.h"
 
 using namespace std;
 using namespace chrono;
@@ -32,50 +33,43 @@ void executeInvestmentStrategy()
     while (true)
     {
         CompanyStatus currentStatus;    // Stores the current company status for processing
-        bool hasStatus = false;         // Flag indicating availability of new data
 
-        // Thread-safe extraction of the next available company status from the queue
-        {
-            lock_guard<mutex> lock(companyStatusQueueMutex);
-            if (!companyStatusQueue.empty())
-            {
-                currentStatus = companyStatusQueue.front(); // Retrieve next status
-                companyStatusQueue.pop();                   // Remove from queue
-                hasStatus = true;                           // Mark that data is ready
-            }
-        }
+        // Sleep until a company status arrives, waking at least once a second to check holdings
+        bool hasStatus = companyStatusQueue.popFor(currentStatus, seconds(1));
 
         if (hasStatus)
         {
             string symbol = currentStatus.stockSymbol;      // Stock symbol of the company
-            double sentimentScore = currentStatus.sentimentScore; // Sentiment score from analysis
-            double similarity = currentStatus.similarity;   // Similarity score for company identification
 
-            // Check if the similarity meets the threshold for reliable identification
-            if (similarity < strategy.similarityThreshold)
-            {
-                // Skip to next iteration if similarity is too low
-                safeCout("[INFO] ", "Similarity below threshold for " + symbol + ", skipping...\n\n");
-                continue;
-            }
+            // Same rules the simulator backtests, built from the live settings
+            ThresholdStrategy rules = makeThresholdStrategy(strategy.investmentPercentage,
+                                                            strategy.positiveSentimentThreshold,
+                                                            strategy.negativeSentimentThreshold,
+                                                            strategy.similarityThreshold,
+                                                            strategy.holdTimeSeconds);
 
-            // Decide actions based on sentiment thresholds
-            if (sentimentScore >= strategy.positiveSentimentThreshold)
+            // Decide actions based on similarity and sentiment thresholds
+            switch (rules.decide(currentStatus.similarity, currentStatus.sentimentScore))
             {
-                // Trigger buy logic if sentiment is strongly positive
-                executeBuyLogic(symbol);
-            }
-            else if (sentimentScore <= strategy.negativeSentimentThreshold)
-            {
-                // Trigger immediate sell logic if sentiment is strongly negative
-                
-                // Implement with stock market API
-            }
-            else
-            {
-                // Log ignored signal due to sentiment being neither strongly positive nor negative
-                safeCout("[INFO] ", "Sentiment outsite both thresholds for " + symbol + ", skipping... \n\n");
-                continue;
+                case StrategyAction::Ignore:
+                    // Skip to next iteration if similarity is too low
+                    safeCout("[INFO] ", "Similarity below threshold for " + symbol + ", skipping...\n\n");
+                    continue;
+
+                case StrategyAction::Sell:
+                    // Trigger immediate sell logic if sentiment is strongly negative
+                    executeSellLogic(symbol);
+                    break;
+
+                case StrategyAction::Buy:
+                    // Trigger buy logic if sentiment is strongly positive
+                    executeBuyLogic(symbol);
+                    break;
+
+                case StrategyAction::Hold:
+                    // Log ignored signal due to sentiment being neither strongly positive nor negative
+                    safeCout("[INFO] ", "Sentiment outsite both thresholds for " + symbol + ", skipping... \n\n");
+                    continue;
             }
         }
 
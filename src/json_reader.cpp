@@ -0,0 +1,386 @@
+// Includes standard C++ libraries and project-specific headers
+#include "../include/json_reader.h"
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// === Escape decoding ===
+
+// Value of one hex digit, or -1
+static int hexDigit(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Reads the four hex digits of a \u escape at raw[i]; -1 if malformed
+static long readHex4(string_view raw, size_t i)
+{
+    if (i + 4 > raw.size()) return -1;
+    long code = 0;
+    for (size_t k = 0; k < 4; ++k)
+    {
+        int d = hexDigit(raw[i + k]);
+        if (d < 0) return -1;
+        code = code * 16 + d;
+    }
+    return code;
+}
+
+// Appends a code point as UTF-8
+static void appendUtf8(uint32_t code, string& out)
+{
+    if (code < 0x80)
+    {
+        out += char(code);
+    }
+    else if (code < 0x800)
+    {
+        out += char(0xC0 | (code >> 6));
+        out += char(0x80 | (code & 0x3F));
+    }
+    else if (code < 0x10000)
+    {
+        out += char(0xE0 | (code >> 12));
+        out += char(0x80 | ((code >> 6) & 0x3F));
+        out += char(0x80 | (code & 0x3F));
+    }
+    else
+    {
+        out += char(0xF0 | (code >> 18));
+        out += char(0x80 | ((code >> 12) & 0x3F));
+        out += char(0x80 | ((code >> 6) & 0x3F));
+        out += char(0x80 | (code & 0x3F));
+    }
+}
+
+// Decodes the escapes of a raw JSON string and appends the text to out
+void appendJsonUnescaped(string_view raw, string& out)
+{
+    out.reserve(out.size() + raw.size());
+    size_t i = 0;
+    while (i < raw.size())
+    {
+        // Copy the run up to the next escape in one go
+        size_t slash = raw.find('\\', i);
+        if (slash == string_view::npos) slash = raw.size();
+        out.append(raw.data() + i, slash - i);
+        i = slash;
+        if (i >= raw.size()) break;
+
+        // JsonReader has checked that a character follows every backslash
+        char c = raw[i + 1];
+        i += 2;
+        switch (c)
+        {
+            case '"':  out += '"';  break;
+            case '\\': out += '\\'; break;
+            case '/':  out += '/';  break;
+            case 'b':  out += '\b'; break;
+            case 'f':  out += '\f'; break;
+            case 'n':  out += '\n'; break;
+            case 'r':  out += '\r'; break;
+            case 't':  out += '\t'; break;
+            case 'u':
+            {
+                long code = readHex4(raw, i);
+                i += 4;
+                if (code >= 0xD800 && code <= 0xDBFF)
+                {
+                    // High surrogate: combine with a following \u low surrogate
+                    long low = (i + 6 <= raw.size() && raw[i] == '\\' && raw[i + 1] == 'u') ? readHex4(raw, i + 2) : -1;
+                    if (low >= 0xDC00 && low <= 0xDFFF)
+                    {
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        i += 6;
+                    }
+                    else
+                    {
+                        code = 0xFFFD;
+                    }
+                }
+                else if (code >= 0xDC00 && code <= 0xDFFF)
+                {
+                    code = 0xFFFD;
+                }
+                appendUtf8(uint32_t(code), out);
+                break;
+            }
+            default:
+                out += c;
+                break;
+        }
+    }
+}
+
+// === String scanning ===
+
+// Bytes of a word that are below 0x20, equal to '"' or equal to '\\' get their
+// high bit set; the others come out 0 (bit tricks on eight bytes at a time)
+static uint64_t stopBytes(uint64_t word)
+{
+    const uint64_t ones = 0x0101010101010101ull;
+    const uint64_t highs = 0x8080808080808080ull;
+    uint64_t quote = word ^ (ones * '"');
+    uint64_t slash = word ^ (ones * '\\');
+    uint64_t isQuote = (quote - ones) & ~quote;
+    uint64_t isSlash = (slash - ones) & ~slash;
+    uint64_t isControl = (word - ones * 0x20) & ~word;
+    return (isQuote | isSlash | isControl) & highs;
+}
+
+// Position of the first quote, backslash or control character at or after pos, or size
+static size_t findStringStop(const char* data, size_t pos, size_t size)
+{
+    while (pos + 8 <= size)
+    {
+        uint64_t word;
+        memcpy(&word, data + pos, 8);
+        uint64_t stops = stopBytes(word);
+        if (stops != 0)
+        {
+            // The lowest flagged byte is exact; flags above it may be false positives, so rescan from it
+            break;
+        }
+        pos += 8;
+    }
+    while (pos < size && data[pos] != '"' && data[pos] != '\\' && static_cast<unsigned char>(data[pos]) >= 0x20)
+    {
+        ++pos;
+    }
+    return pos;
+}
+
+// === JsonReader ===
+
+// Reads the next token
+JsonToken JsonReader::next()
+{
+    value = {};
+    hasEscapes = false;
+    closedContainer = false;
+    skipSpace();
+
+    if (containers.empty())
+    {
+        if (rootDone)
+        {
+            if (pos < input.size()) fail("unexpected data after the document");
+            return JsonToken::End;
+        }
+        if (pos >= input.size()) fail("empty document");
+        return readValue();
+    }
+    if (pos >= input.size()) fail("unexpected end of input");
+
+    Container& top = containers.back();
+    if (expectValue)
+    {
+        expectValue = false;
+        return readValue();
+    }
+
+    // Closing bracket of the current container
+    char close = top.type == '{' ? '}' : ']';
+    if (input[pos] == close)
+    {
+        ++pos;
+        containers.pop_back();
+        closedContainer = true;
+        if (containers.empty()) rootDone = true;
+        return close == '}' ? JsonToken::ObjectEnd : JsonToken::ArrayEnd;
+    }
+
+    // Members after the first are separated by commas
+    if (!top.first)
+    {
+        if (input[pos] != ',') fail(string("expected ',' or '") + close + "'");
+        ++pos;
+        skipSpace();
+        if (pos >= input.size()) fail("unexpected end of input");
+    }
+    top.first = false;
+
+    if (top.type == '[') return readValue();
+
+    // Object member: key, colon, then the value on the next call
+    if (input[pos] != '"') fail("expected a member name");
+    readString();
+    skipSpace();
+    if (pos >= input.size() || input[pos] != ':') fail("expected ':'");
+    ++pos;
+    expectValue = true;
+    return JsonToken::Key;
+}
+
+// Reads the next value and everything nested in it; returns the value's first token
+JsonToken JsonReader::skipValue()
+{
+    JsonToken first = next();
+    if (first != JsonToken::ObjectStart && first != JsonToken::ArrayStart) return first;
+
+    size_t level = containers.size();
+    while (containers.size() >= level)
+    {
+        next();
+    }
+    return first;
+}
+
+// Reads a value starting at the current character
+JsonToken JsonReader::readValue()
+{
+    char c = input[pos];
+    switch (c)
+    {
+        case '{':
+        case '[':
+            ++pos;
+            containers.push_back({c, true});
+            return c == '{' ? JsonToken::ObjectStart : JsonToken::ArrayStart;
+        case '"':
+            readString();
+            if (containers.empty()) rootDone = true;
+            return JsonToken::String;
+        case 't': return readLiteral("true", JsonToken::True);
+        case 'f': return readLiteral("false", JsonToken::False);
+        case 'n': return readLiteral("null", JsonToken::Null);
+        default:
+            if (c == '-' || (c >= '0' && c <= '9'))
+            {
+                readNumber();
+                if (containers.empty()) rootDone = true;
+                return JsonToken::Number;
+            }
+            fail(string("unexpected character '") + c + "'");
+    }
+}
+
+// Reads a string at pos (on the opening quote) into value
+void JsonReader::readString()
+{
+    size_t start = ++pos;
+    const char* data = input.data();
+    size_t size = input.size();
+    while (true)
+    {
+        // Plain characters are the common case; only quotes, escapes and control characters stop the scan
+        pos = findStringStop(data, pos, size);
+        if (pos >= size) fail("unterminated string");
+
+        char c = data[pos];
+        if (c == '"') break;
+        if (c != '\\') fail("control character in string");
+
+        // Check the escape now, so text() can decode without failing
+        if (pos + 1 >= size) fail("unterminated string");
+        char e = data[pos + 1];
+        if (e == 'u')
+        {
+            if (readHex4(input, pos + 2) < 0) fail("malformed \\u escape");
+            pos += 6;
+        }
+        else if (string_view("\"\\/bfnrt").find(e) != string_view::npos)
+        {
+            pos += 2;
+        }
+        else
+        {
+            fail(string("invalid escape '\\") + e + "'");
+        }
+        hasEscapes = true;
+    }
+    value = input.substr(start, pos - start);
+    ++pos;
+}
+
+// Reads a number at pos into value
+void JsonReader::readNumber()
+{
+    size_t start = pos;
+    auto digits = [&]()
+    {
+        size_t from = pos;
+        while (pos < input.size() && input[pos] >= '0' && input[pos] <= '9') ++pos;
+        return pos > from;
+    };
+
+    if (input[pos] == '-') ++pos;
+    if (pos < input.size() && input[pos] == '0')
+    {
+        ++pos;
+    }
+    else if (!digits())
+    {
+        fail("malformed number");
+    }
+    if (pos < input.size() && input[pos] == '.')
+    {
+        ++pos;
+        if (!digits()) fail("malformed number");
+    }
+    if (pos < input.size() && (input[pos] == 'e' || input[pos] == 'E'))
+    {
+        ++pos;
+        if (pos < input.size() && (input[pos] == '+' || input[pos] == '-')) ++pos;
+        if (!digits()) fail("malformed number");
+    }
+    value = input.substr(start, pos - start);
+}
+
+// Reads an expected literal (true, false, null)
+JsonToken JsonReader::readLiteral(string_view word, JsonToken token)
+{
+    if (input.substr(pos, word.size()) != word) fail("unexpected character '" + string(1, input[pos]) + "'");
+    pos += word.size();
+    if (containers.empty()) rootDone = true;
+    return token;
+}
+
+// Skips JSON whitespace
+void JsonReader::skipSpace()
+{
+    const char* data = input.data();
+    size_t size = input.size();
+    while (pos < size)
+    {
+        // Pretty-printed input is mostly indentation; take runs of spaces eight at a time
+        uint64_t word;
+        if (pos + 8 <= size && (memcpy(&word, data + pos, 8), word == 0x2020202020202020ull))
+        {
+            pos += 8;
+            continue;
+        }
+        char c = data[pos];
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t') break;
+        ++pos;
+    }
+}
+
+// Key/String with escapes decoded
+string JsonReader::text() const
+{
+    if (!hasEscapes) return string(value);
+    string out;
+    appendJsonUnescaped(value, out);
+    return out;
+}
+
+// Number as a double
+double JsonReader::number() const
+{
+    double result = 0.0;
+    auto [end, ec] = from_chars(value.data(), value.data() + value.size(), result);
+    if (ec != errc() || end != value.data() + value.size())
+    {
+        throw runtime_error("JSON number out of range: " + string(value));
+    }
+    return result;
+}
+
+[[noreturn]] void JsonReader::fail(const string& what) const
+{
+    throw runtime_error("Malformed JSON at byte " + to_string(pos) + ": " + what);
+}
@@ -2,40 +2,24 @@
 #include "../include/news_fetcher.h"
 #include "../include/utils.h"
 #include "../include/news_parser.h"
+#include "../include/child_process.h"
 #include <bits/stdc++.h>
 
 using namespace std;
 using namespace chrono;
 
+// Longest one MarketAux request may take before the fetcher is killed
+static const int FETCH_TIMEOUT_SECONDS = 60;
+
 // Function to run the Python script with the given MarketAux API URL and capture its output
 string fetchNewsFromAPI(const string apiUrl) 
 {
-    string result;
-
-    // Build the command:
-    // - Calls the specific Python interpreter
-    // - Passes the full API URL to marketaux_fetcher.py
-    // - Redirects stderr (2) to stdout (1) to capture all output
-    string command = cfg.pythonInterpreter + " \"scripts/marketaux_fetcher.py\" \"" + apiUrl + "\" 2>&1";
-
-    // Open a pipe to execute the command
-    FILE* pipe = _popen(command.c_str(), "r");
-    if(!pipe) 
-    {
-        throw runtime_error("Failed to open pipe.");
-    }
-
-    // Buffer for reading chunks of output from the pipe
-    char buffer[4096];
-
-    // Read and accumulate the output
-    while(fgets(buffer, sizeof(buffer), pipe) != nullptr) 
-    {
-        result += buffer;
-    }
-
-    // Close the pipe and retrieve the exit status of the script
-    int returnCode = _pclose(pipe);
+    // Run marketaux_fetcher.py directly with the full API URL as its argument.
+    // Only stdout is captured: it holds the JSON response, while warnings the
+    // HTTP libraries print to stderr go to our console instead of in front of it
+    vector<string> command = {cfg.pythonInterpreter, "scripts/marketaux_fetcher.py", apiUrl};
+    int returnCode = 0;
+    string result = runProcess(command, FETCH_TIMEOUT_SECONDS, returnCode, "marketaux_fetcher.py", false);
 
     // If the script returned an error code, throw an exception with the code
     if(returnCode != 0)
@@ -72,12 +56,9 @@ void newsPolling()
             // Fetch MarketAux news for the given time window
             string response = fetchNewsFromAPI(apiUrl);
             
-            // Extract news items from the raw JSON string and add them to the global queue (newsQueue)
-            // Process the response in a new thread so it's non-blocking 
-            thread processorThread(extractNewsFromResponse, response);
-
-            // We don't wait for it to finish
-            processorThread.detach();
+            // Extract news items from the raw JSON string and hand them to the scraping pool,
+            // which adds each to the global queue (newsQueue) once its text is fetched
+            extractNewsFromResponse(response);
         } 
         catch(const exception& e) 
         {
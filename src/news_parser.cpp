@@ -2,40 +2,35 @@
 #include "../include/news_parser.h"
 #include "../include/utils.h"
 #include "../include/globals.h"
+#include "../include/scrape_pool.h"
+#include "../include/json_reader.h"
+#include "../include/child_process.h"
 #include <bits/stdc++.h>
 
 using namespace std;
 
-// Function to run the Python script with the given article URL and capture its output
-string getArticleText(string url) 
-{
-    string result;
-
-    // Build the command:
-    // - Uses the specified Python interpreter
-    // - Executes article_scraper.py with the provided URL
-    // - Redirects stderr (2) to stdout (1) to capture all output together
-    string command = cfg.pythonInterpreter + " \"scripts/article_scraper.py\" \"" + url + "\" 2>&1";
+// Time on top of the scrape timeout for the interpreter to start and import newspaper3k
+static const int SCRAPER_STARTUP_SECONDS = 15;
 
-    // Open a pipe to execute the command and read its output
-    FILE* pipe = _popen(command.c_str(), "r");
-    if(!pipe)
-    {
-        // If the pipe couldn't be opened, throw an exception
-        throw runtime_error("Failed to open pipe.");
-    }
-
-    // Buffer for reading the script's output in chunks
-    char buffer[4096];
-
-    // Read the output line by line and accumulate it in the result string
-    while(fgets(buffer, sizeof(buffer), pipe) != nullptr)
-    {
-        result += buffer;
-    }
+// Shared scraping stage, started by the first poll and kept for the life of the program
+static ScrapePool& scrapePool()
+{
+    static ScrapePool pool(cfg.scrapeWorkers > 0 ? cfg.scrapeWorkers : 16,
+                           cfg.scrapePerDomain > 0 ? cfg.scrapePerDomain : 2,
+                           cfg.scrapeTimeoutSeconds > 0 ? cfg.scrapeTimeoutSeconds : 20);
+    return pool;
+}
 
-    // Close the pipe and get the script's exit status
-    int returnCode = _pclose(pipe);
+// Function to run the Python script with the given article URL and capture its output
+string getArticleText(string url, int timeoutSeconds) 
+{
+    // Run article_scraper.py with the URL and download timeout as plain arguments:
+    // no shell is involved, so nothing in the URL can be run as a command.
+    // The script gives up after timeoutSeconds itself; it is killed if it also
+    // hangs in interpreter startup
+    vector<string> command = {cfg.pythonInterpreter, "scripts/article_scraper.py", url, to_string(timeoutSeconds)};
+    int returnCode = 0;
+    string result = runProcess(command, timeoutSeconds + SCRAPER_STARTUP_SECONDS, returnCode, "article_scraper.py");
 
     // If the Python script exited with an error code, throw an exception
     if(returnCode != 0)
@@ -43,88 +38,82 @@ string getArticleText(string url)
         throw runtime_error("article_scraper.py failed with code " + to_string(returnCode));
     }
 
-    // Return the full article text (or output) from the script
+    // Return the full article text (or output) from the script; stderr is captured with it
     return result;
 }
 
-// Function to extract news items from the raw JSON string and add them to the global queue
-void extractNewsFromResponse(const string response)
+// Parses the articles (title, url, published_at) of a MarketAux response; members of
+// nested objects such as "entities" and "similar" are skipped, not mistaken for articles
+vector<NewsItem> parseNewsResponse(string_view response)
 {
-    size_t pos = 0;
+    vector<NewsItem> items;
+    JsonReader reader(response);
+    if (reader.next() != JsonToken::ObjectStart)
+    {
+        throw runtime_error("MarketAux response is not a JSON object");
+    }
 
-    while(true)
+    // Root members: everything but "data" is skipped
+    while (reader.next() == JsonToken::Key)
     {
-        // Find the start of a new article by locating the next "title" field
-        pos = response.find("\"title\":", pos);
-        
-        // Exiting the loop if there are no more articles found in the response
-        if(pos == string::npos) 
+        if (reader.raw() != "data")
         {
-            safeCout("[INFO] ", "No more articles to extract from JSON response.\n\n");
-            break;
+            reader.skipValue();
+            continue;
         }
-
-        NewsItem item;
-
-        // Extract title
-        size_t start = response.find("\"", pos + 8) + 1;
-        size_t end = response.find("\"", start);
-        item.title = response.substr(start, end - start);
-        pos = end;
-
-        // Extract url
-        pos = response.find("\"url\":", pos);
-        if(pos == string::npos) 
+        if (reader.next() != JsonToken::ArrayStart)
         {
-            break;
+            throw runtime_error("MarketAux \"data\" is not an array");
         }
-        start = response.find("\"", pos + 6) + 1;
-        end = response.find("\"", start);
-        item.url = response.substr(start, end - start);
-        pos = end;
 
-        
-        // Extract published_at
-        pos = response.find("\"published_at\":", pos);
-        if(pos == string::npos) 
+        // One object per article
+        for (JsonToken t = reader.next(); t != JsonToken::ArrayEnd; t = reader.next())
         {
-            break;
+            if (t != JsonToken::ObjectStart)
+            {
+                throw runtime_error("MarketAux article is not a JSON object");
+            }
+            NewsItem item;
+            while (reader.next() == JsonToken::Key)
+            {
+                string_view key = reader.raw();
+                string* field = key == "title" ? &item.title
+                              : key == "url" ? &item.url
+                              : key == "published_at" ? &item.publishedAt
+                              : nullptr;
+                // A string value stays readable after skipValue(); anything else is ignored
+                if (reader.skipValue() == JsonToken::String && field)
+                {
+                    *field = reader.text();
+                }
+            }
+            if (!item.url.empty()) items.push_back(move(item));
         }
-        start = response.find("\"", pos + 16) + 1;
-        end = response.find("\"", start);
-        item.publishedAt = response.substr(start, end - start);
-        pos = end;
+    }
+    return items;
+}
 
-        // Skip duplicates if we've already seen this URL
-        if(seenUrls.count(item.url))
+// Function to extract news items from the raw JSON string and queue them for scraping
+void extractNewsFromResponse(const string response)
+{
+    vector<NewsItem> items = parseNewsResponse(response);
+    safeCout("[INFO] ", "Extracted " + to_string(items.size()) + " articles from JSON response.\n\n");
+
+    for (NewsItem& item : items)
+    {
+        // Marks an item as seen, so a later poll doesn't queue it again; the scrape pool
+        // erases the mark if the scrape fails. Skip duplicates if we've already seen this URL
+        if(!seenUrls.insert(item.url))
         {
             safeCout("[INFO] ", "Skipping duplicate: " + item.url + "\n\n");
             continue;
         }
 
-        // Try to fetch full article text from the URL using article_scraper.py
-        try
-        {
-            // Get the full article text by calling the Python script
-            item.text = getArticleText(item.url);
-        
-            // Push the item into the global queue
-            {
-                lock_guard<mutex> lock(newsQueueMutex);
-                newsQueue.push(item);
-            }
-            
-            // Marks an item as seen
-            seenUrls.insert(item.url);
-            
-            // Confirm successful processing
-            safeCout("[INFO] ", "News article from URL: " + item.url + "\n - successfully parsed and added to queue.\n\n");
-        }
-        catch(const exception& e)
+        // Fetch the full article text in the background; it reaches the news queue when done
+        string url = item.url;
+        if(!scrapePool().submit(move(item)))
         {
-            // Print any error that occurred
-            safeCerr("[WARN] ", "News article from URL: " + item.url + "\n - failed to be parsed and was not added to queue.\n");
-            safeCerr("[ERROR] ", string(e.what()) + "\n\n");  // print the specific error
+            safeCout("[INFO] ", "Skipping duplicate: " + url + " (already being scraped)\n\n");
         }
     }
-}
\ No newline at end of file
+}
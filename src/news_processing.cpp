@@ -1,156 +1,105 @@
 // Includes standard C++ libraries and project-specific headers
 #include "../include/news_processing.h"
 #include "../include/globals.h"
+#include "../include/company_index.h"
+#include "../include/python_worker.h"
+#include "../include/child_process.h"
 #include "../include/utils.h"
 #include <bits/stdc++.h>
 
 using namespace std;
+using namespace chrono;
 
-// Function to detect the most relevant company mentioned in the news article
-tuple<string, string, double> detectCompanyInNews(string articleTitle, string articleText)
-{
-    string command = cfg.pythonInterpreter + " \"scripts/company_matcher.py\""
-                     + " \"" + cfg.astraDBApplicationToken + "\""
-                     + " \"" + cfg.astraDBApiEndpoint        + "\""
-                     + " \"" + cfg.openAIApi                 + "\""
-                     + " \"" + articleTitle                  + "\""
-                     + " \"" + articleText                   + "\""
-                     + " 2>&1";
-
-    // Open a pipe to execute the command and capture its output
-    FILE* pipe = _popen(command.c_str(), "r");
-    if (!pipe)
-    {
-        // If the pipe couldn't be opened, throw an exception
-        throw runtime_error("Failed to open pipe to company_matcher.py");
-    }
-
-    // Read the script's output into a result string
-    string result;
-    char buffer[4096];
-    while (fgets(buffer, sizeof(buffer), pipe) != nullptr)
-    {
-        result += buffer;
-    }
-
-    // Close the pipe and check the script's exit status
-    int returnCode = _pclose(pipe);
-    if (returnCode != 0)
-    {
-        throw runtime_error("company_matcher.py failed with code " + to_string(returnCode));
-    }
-
-    // Remove newline characters and outer brackets from the JSON array
-    result.erase(remove(result.begin(), result.end(), '\n'), result.end());
-    result.erase(remove(result.begin(), result.end(), '['), result.end());
-    result.erase(remove(result.begin(), result.end(), ']'), result.end());
-
-    // Initialize variables for extracted values
-    string name, ticker;
-    float similarity = 0.0f;
-
-    // Locate the positions of each field in the JSON string
-    size_t namePos = result.find("\"name\":");
-    size_t tickerPos = result.find("\"ticker\":");
-    size_t simPos = result.find("\"similarity\":");
-
-    // Validate that all required fields were found
-    if (namePos == string::npos || tickerPos == string::npos || simPos == string::npos)
-    {
-        throw runtime_error("Failed to parse company_matcher.py output");
-    }
-
-    // Extract company name value
-    namePos = result.find('"', namePos + 7) + 1;
-    size_t nameEnd = result.find('"', namePos);
-    name = result.substr(namePos, nameEnd - namePos);
-
-    // Extract ticker symbol value
-    tickerPos = result.find('"', tickerPos + 9) + 1;
-    size_t tickerEnd = result.find('"', tickerPos);
-    ticker = result.substr(tickerPos, tickerEnd - tickerPos);
+// Longest the one-time AstraDB export may take before it is killed
+static const int COMPANY_EXPORT_TIMEOUT_SECONDS = 3600;
 
-    // Extract similarity score and convert to float
-    simPos = result.find(':', simPos) + 1;
-    string simStr = result.substr(simPos, result.find('}', simPos) - simPos);
-    similarity = stof(simStr);
+// Company embeddings, loaded by loadCompanyIndex() before the processing thread starts
+static CompanyIndex companyIndex;
 
-    // Return extracted values as a tuple
-    return {name, ticker, similarity};
+// Shared embedding process, started by the first article and reused for the life of the program
+static PythonWorker& embeddingWorker()
+{
+    static PythonWorker worker(cfg.pythonInterpreter, "scripts/embedding_worker.py", {cfg.openAIApi});
+    return worker;
 }
 
-
-// Sentiment analysis function to extract positivity and score
-float analyzeSentiment(string title, string text)
+// Shared sentiment process, started by the first article and reused for the life of the program
+static PythonWorker& sentimentWorker()
 {
-    string result;
-
-    // Command to call the Python script
-    string command = cfg.pythonInterpreter +
-                     " \"scripts/sentiment_analyzer.py\"" +
-                     " \"" + (cfg.useGPU ? "True" : "False") + "\"" +
-                     " \"" + title + "\"" +
-                     " \"" + text  + "\"" +
-                     " 2>&1";
-
-    // Open a pipe to execute the command and read its output
-    FILE* pipe = _popen(command.c_str(), "r");
-    if (!pipe)
-    {
-        // If the pipe couldn't be opened, throw an exception
-        throw runtime_error("Failed to open pipe.");
-    }
+    static PythonWorker worker(cfg.pythonInterpreter, "scripts/sentiment_worker.py",
+                               {cfg.useGPU ? "True" : "False",
+                                to_string(cfg.sentimentBatchSize > 0 ? cfg.sentimentBatchSize : 16)});
+    return worker;
+}
 
-    // Buffer for reading the script's output in chunks
-    char buffer[4096];
+// Loads the company embeddings into memory, exporting them from AstraDB first if there is no local copy
+void loadCompanyIndex()
+{
+    string path = cfg.companyEmbeddingsFile.empty() ? "companies.bin" : cfg.companyEmbeddingsFile;
 
-    // Read the output line by line and accumulate it in the result string
-    while (fgets(buffer, sizeof(buffer), pipe) != nullptr)
+    if (!filesystem::exists(path))
     {
-        result += buffer;
+        // Run the exporter directly, so the token, endpoint and path reach it as plain arguments
+        vector<string> command = {cfg.pythonInterpreter, "scripts/company_exporter.py",
+                                  cfg.astraDBApplicationToken, cfg.astraDBApiEndpoint, path};
+        int returnCode = 0;
+        string result = runProcess(command, COMPANY_EXPORT_TIMEOUT_SECONDS, returnCode, "company_exporter.py");
+
+        // Check the script's exit status
+        if (returnCode != 0)
+        {
+            throw runtime_error("company_exporter.py failed with code " + to_string(returnCode) + ": " + result);
+        }
+        safeCout("[INFO] ", result + "\n");
     }
 
-    // Close the pipe and get the script's exit status
-    int returnCode = _pclose(pipe);
-
-    // If the Python script exited with an error code, throw an exception
-    if (returnCode != 0)
-    {
-        throw runtime_error("sentiment_analysis.py failed with code " + to_string(returnCode));
-    }
+    companyIndex.load(path);
+    string mode = cfg.companyIndex.empty() ? "int8" : cfg.companyIndex;
+    companyIndex.build(parseCompanyIndexMode(mode));
+    safeCout("[INFO] ", "Loaded " + to_string(companyIndex.size()) + " company embeddings ("
+                        + to_string(companyIndex.dimension()) + " dimensions, " + mode + " search) from " + path + "\n\n");
+}
 
-    // Extract the label (POSITIVE, NEGATIVE, NEUTRAL)
-    size_t labelPos = result.find("{'label': '");
-    if (labelPos == string::npos)
+// Function to detect the most relevant company mentioned in the news article
+tuple<string, string, double> detectCompanyInNews(string articleTitle, string articleText)
+{
+    // Embed title and text together; the reply is "VEC " and little-endian float32 values
+    string reply = embeddingWorker().request(articleTitle + " " + articleText);
+    size_t values = reply.size() >= 4 ? (reply.size() - 4) / sizeof(float) : 0;
+    if (reply.compare(0, 4, "VEC ") != 0 || values != companyIndex.dimension())
     {
-        throw runtime_error("Failed to find 'label' in sentiment analysis result.");
+        throw runtime_error("embedding_worker.py returned " + to_string(values) + " values, company index has "
+                            + to_string(companyIndex.dimension()));
     }
+    vector<float> embedding(values);
+    memcpy(embedding.data(), reply.data() + 4, values * sizeof(float));
 
-    labelPos += 11;  // Skip over "{'label': '"
-    size_t labelEnd = result.find("'", labelPos);
-    if (labelEnd == string::npos)
+    // Nearest company in the in-memory index
+    vector<CompanyMatch> matches = companyIndex.search(embedding.data(), 1);
+    if (matches.empty())
     {
-        throw runtime_error("Failed to extract label.");
+        throw runtime_error("Company index is empty");
     }
 
-    string label = result.substr(labelPos, labelEnd - labelPos);
+    // Return extracted values as a tuple
+    const CompanyMatch& best = matches.front();
+    return {companyIndex.name(best.company), companyIndex.ticker(best.company), best.similarity};
+}
 
-    // Extract the score
-    size_t scorePos = result.find("'score': ", labelEnd);
-    if (scorePos == string::npos)
-    {
-        throw runtime_error("Failed to find 'score' in sentiment analysis result.");
-    }
 
-    scorePos += 9;  // Skip over "'score': "
-    size_t scoreEnd = result.find('}', scorePos);
-    if (scoreEnd == string::npos)
+// Sentiment analysis function to extract positivity and score
+float analyzeSentiment(string title, string text)
+{
+    // Classify title and text together, as one article; the reply is "<LABEL> <score>"
+    string reply = sentimentWorker().request(title + " " + text);
+    string label;
+    float score;
+    istringstream in(reply);
+    if (!(in >> label >> score))
     {
-        throw runtime_error("Failed to extract score.");
+        throw runtime_error("Failed to parse sentiment_worker.py reply: " + reply);
     }
 
-    float score = stof(result.substr(scorePos, scoreEnd - scorePos));  // Convert string to float
-
     // Convert to signed value in [-1.0, 1.0]
     if(label == "NEUTRAL")
     {
@@ -165,67 +114,101 @@ float analyzeSentiment(string title, string text)
     return score;
 }
 
-// Function to process news articles from the global queue of parsed news items
-void processNewsArticles()
+// Per-stage totals since startup, read by stageStatistics()
+static atomic<uint64_t> articlesProcessed{0};
+static atomic<uint64_t> companyMicros{0};
+static atomic<uint64_t> sentimentMicros{0};
+static atomic<uint64_t> articleMicros{0};
+
+// Snapshot of the per-stage totals
+ProcessingStats stageStatistics()
 {
-    // Log the start of the processNewsArticles thread
-    safeCout("[INFO] ", "Starting thread: processNewsArticles\n\n");
+    return {articlesProcessed.load(), companyMicros.load(), sentimentMicros.load(), articleMicros.load()};
+}
+
+// Microseconds elapsed since a start time
+static uint64_t microsSince(steady_clock::time_point start)
+{
+    return uint64_t(duration_cast<microseconds>(steady_clock::now() - start).count());
+}
 
-    while(true) 
+// Company matching and sentiment for one article, run side by side
+static CompanyStatus processArticle(const NewsItem& news)
+{
+    auto articleStart = steady_clock::now();
+
+    // Sentiment on a helper thread while this thread matches the company
+    future<float> sentiment = async(launch::async, [&news]
     {
-        // Check if there are news articles in the queue to process
-        NewsItem currentNews;
-        bool hasNews = false;
+        auto start = steady_clock::now();
+        float score = analyzeSentiment(news.title, news.text);
+        sentimentMicros += microsSince(start);
+        return score;
+    });
+
+    // Detect a company in the article; the future's destructor waits for sentiment if this throws
+    auto start = steady_clock::now();
+    tuple<string, string, double> company = detectCompanyInNews(news.title, news.text);
+    companyMicros += microsSince(start);
+
+    // Create a CompanyStatus object with the results
+    CompanyStatus status;
+    status.companyName = get<0>(company);
+    status.stockSymbol = get<1>(company);
+    status.similarity = get<2>(company);
+    status.sentimentScore = sentiment.get();
+    status.timeAdded = news.publishedAt;          // Add the timestamp
+
+    articleMicros += microsSince(articleStart);
+    ++articlesProcessed;
+    return status;
+}
 
+// Takes articles off the global queue until it is closed
+static void processingWorker()
+{
+    // Sleep until the oldest article arrives (FIFO order); ends when the queue is closed
+    NewsItem currentNews;
+    while(newsQueue.pop(currentNews)) 
+    {
+        try
         {
-            lock_guard<mutex> lock(newsQueueMutex);
-            if(!newsQueue.empty()) 
+            CompanyStatus status = processArticle(currentNews);
+
+            // Add the CompanyStatus to the companyStatusQueue for further processing
+            if(!companyStatusQueue.push(status))
             {
-                // Get the oldest item from the queue (FIFO order)
-                currentNews = newsQueue.front();  // Remove the processed article from the queue
-                newsQueue.pop();
-                hasNews = true;
+                safeCerr("[WARN] ", "Company status queue full, dropped result for url " + currentNews.url + "\n\n");
+                continue;
             }
-        }
 
-        if(hasNews) 
+            // Confirm successful processing
+            safeCout("[INFO] ", "Sentiment for " + status.companyName + " (" + status.stockSymbol + ") from url " + currentNews.url + "\n - successfully processed and added to queue.\n\n");
+        }
+        catch (const exception& e)
         {
-            try
-            {
-                // Extract the title and text from the news item
-                string title = currentNews.title;
-                string text = currentNews.text;
-
-                // Detect a company in the article using the detectCompanyInNews function
-                tuple<string, string, double> company = detectCompanyInNews(title, text);
-
-                string companyName = get<0>(company);
-                string stockSymbol = get<1>(company);
-                double similarity = get<2>(company);
-
-                // Create a CompanyStatus object with the results
-                CompanyStatus status;
-                status.companyName = companyName;
-                status.stockSymbol = stockSymbol;
-                status.similarity = similarity;
-                status.sentimentScore = analyzeSentiment(title, text);   // Perform sentiment analysis for the article
-                status.timeAdded = currentNews.publishedAt;         // Add the timestamp
-                
-                // Add the CompanyStatus to the companyStatusQueue for further processing
-                {
-                    lock_guard<mutex> lock(companyStatusQueueMutex);
-                    companyStatusQueue.push(status);
-                }
-
-                // Confirm successful processing
-                safeCout("[INFO] ", "Sentiment for " + companyName + " (" + stockSymbol + ") from url " + currentNews.url + "\n - successfully processed and added to queue.\n\n");
-            }
-            catch (const exception& e)
-            {
-                // Handle errors during sentiment analysis
-                safeCerr("[Error] ", string(e.what()) + "\n");
-            }
+            // Handle errors during company matching or sentiment analysis
+            safeCerr("[Error] ", string(e.what()) + "\n");
         }
     }
 }
 
+// Function to process news articles from the global queue of parsed news items
+void processNewsArticles()
+{
+    // Several articles are in flight at once, so the Python workers can batch them
+    int workers = cfg.processingWorkers > 0 ? cfg.processingWorkers : 4;
+
+    // Log the start of the processNewsArticles thread
+    safeCout("[INFO] ", "Starting thread: processNewsArticles (" + to_string(workers) + " workers)\n\n");
+
+    vector<thread> pool;
+    for (int i = 0; i < workers; ++i)
+    {
+        pool.emplace_back(processingWorker);
+    }
+    for (auto& t : pool)
+    {
+        t.join();
+    }
+}
@@ -0,0 +1,234 @@
+// Includes platform process/pipe APIs, standard C++ libraries and project-specific headers
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#include "../include/python_worker.h"
+#include "../include/child_process.h"
+#include "../include/utils.h"
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// === Frame encoding ===
+
+// Stores a uint32 little endian, independent of the host byte order
+static void putU32(unsigned char* out, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i) out[i] = static_cast<unsigned char>(value >> (8 * i));
+}
+
+// Reads a little-endian uint32
+static uint32_t getU32(const unsigned char* in)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) value |= static_cast<uint32_t>(in[i]) << (8 * i);
+    return value;
+}
+
+// === PythonWorker ===
+
+// Command line of the worker process; nothing is started yet
+PythonWorker::PythonWorker(string interpreter, string script, vector<string> arguments)
+    : interpreter(move(interpreter)), script(move(script)), arguments(move(arguments))
+{
+    scriptName = filesystem::path(this->script).filename().string();
+}
+
+// Closes the worker's stdin, lets it finish and waits for it to exit
+PythonWorker::~PythonWorker()
+{
+    {
+        lock_guard<mutex> lock(stateMutex);
+        stopping = true;
+    }
+
+    // End of input makes the worker answer what it has and exit,
+    // which in turn ends the reader thread
+    {
+        lock_guard<mutex> lock(writeMutex);
+#ifdef _WIN32
+        if (toWorker) CloseHandle(toWorker);
+        toWorker = nullptr;
+#else
+        if (toWorker >= 0) close(toWorker);
+        toWorker = -1;
+#endif
+    }
+    if (reader.joinable()) reader.join();
+    closeProcess();
+}
+
+// Sends one request and blocks until the worker answers
+string PythonWorker::request(const string& payload)
+{
+    auto slot = make_shared<Request>();
+    uint32_t id;
+    {
+        lock_guard<mutex> lock(stateMutex);
+        if (!running) start();
+        id = nextId++;
+        pending[id] = slot;
+    }
+
+    if (!writeFrame(id, payload))
+    {
+        lock_guard<mutex> lock(stateMutex);
+        pending.erase(id);
+        throw runtime_error("Failed to send request to " + scriptName);
+    }
+
+    // Wait for the reader thread to hand over the response
+    {
+        unique_lock<mutex> lock(stateMutex);
+        answered.wait(lock, [&]{ return slot->done; });
+    }
+    if (slot->failed) throw runtime_error(slot->payload);
+    if (slot->payload.rfind("ERROR ", 0) == 0)
+    {
+        throw runtime_error(scriptName + ": " + slot->payload.substr(6));
+    }
+    return move(slot->payload);
+}
+
+// Launches the process and its reader thread (stateMutex held)
+void PythonWorker::start()
+{
+    // The previous reader has set running = false and is about to return
+    if (reader.joinable()) reader.join();
+    closeProcess();
+
+    vector<string> command = {interpreter, script};
+    command.insert(command.end(), arguments.begin(), arguments.end());
+    ChildProcess child = spawnProcess(command, false, scriptName);   // Model warnings go to our console
+
+    // Writers read the handles under writeMutex, as closeProcess() resets them
+    {
+        lock_guard<mutex> lock(writeMutex);
+        process = child.process;
+        toWorker = child.input;
+        fromWorker = child.output;
+    }
+
+    running = true;
+    reader = thread(&PythonWorker::readLoop, this);
+}
+
+// Closes the pipes and reaps the process (stateMutex held, reader joined)
+void PythonWorker::closeProcess()
+{
+    // Waits for writers still using the old pipe
+    lock_guard<mutex> lock(writeMutex);
+#ifdef _WIN32
+    if (toWorker) CloseHandle(toWorker);
+    if (fromWorker) CloseHandle(fromWorker);
+    if (process)
+    {
+        // Its stdout is closed, so it is already exiting
+        if (WaitForSingleObject(process, 5000) == WAIT_TIMEOUT) TerminateProcess(process, 1);
+        CloseHandle(process);
+    }
+    toWorker = fromWorker = process = nullptr;
+#else
+    if (toWorker >= 0) close(toWorker);
+    if (fromWorker >= 0) close(fromWorker);
+    if (process > 0)
+    {
+        // Its stdout is closed, so it is already exiting
+        int status;
+        waitpid(process, &status, 0);
+    }
+    toWorker = fromWorker = process = -1;
+#endif
+}
+
+// Reads response frames until the worker's stdout closes
+void PythonWorker::readLoop()
+{
+    unsigned char header[8];
+    string payload;
+    while (readAll(reinterpret_cast<char*>(header), sizeof(header)))
+    {
+        uint32_t id = getU32(header);
+        payload.resize(getU32(header + 4));
+        if (!payload.empty() && !readAll(&payload[0], payload.size())) break;
+
+        // Responses to requests that already failed are dropped
+        lock_guard<mutex> lock(stateMutex);
+        auto it = pending.find(id);
+        if (it == pending.end()) continue;
+        it->second->payload = payload;
+        it->second->done = true;
+        pending.erase(it);
+        answered.notify_all();
+    }
+
+    // The worker exited: fail everything still waiting; the next request restarts it
+    lock_guard<mutex> lock(stateMutex);
+    if (!stopping)
+    {
+        safeCerr("[Error] ", scriptName + " exited; it will be restarted by the next request\n");
+    }
+    for (auto& entry : pending)
+    {
+        entry.second->payload = scriptName + " exited before answering";
+        entry.second->failed = true;
+        entry.second->done = true;
+    }
+    pending.clear();
+    running = false;
+    answered.notify_all();
+}
+
+// Writes one request frame; false if the pipe is broken
+bool PythonWorker::writeFrame(uint32_t id, const string& payload)
+{
+    unsigned char header[8];
+    putU32(header, id);
+    putU32(header + 4, static_cast<uint32_t>(payload.size()));
+
+    lock_guard<mutex> lock(writeMutex);
+    return writeAll(reinterpret_cast<const char*>(header), sizeof(header)) &&
+           writeAll(payload.data(), payload.size());
+}
+
+// Writes the whole buffer to the worker's stdin
+bool PythonWorker::writeAll(const char* data, size_t size)
+{
+    while (size > 0)
+    {
+#ifdef _WIN32
+        DWORD written;
+        if (!toWorker || !WriteFile(toWorker, data, static_cast<DWORD>(size), &written, nullptr)) return false;
+#else
+        if (toWorker < 0) return false;
+        ssize_t written = write(toWorker, data, size);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return false;
+#endif
+        data += written;
+        size -= written;
+    }
+    return true;
+}
+
+// Fills the whole buffer from the worker's stdout
+bool PythonWorker::readAll(char* data, size_t size)
+{
+    while (size > 0)
+    {
+#ifdef _WIN32
+        DWORD got;
+        if (!ReadFile(fromWorker, data, static_cast<DWORD>(size), &got, nullptr) || got == 0) return false;
+#else
+        ssize_t got = read(fromWorker, data, size);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+#endif
+        data += got;
+        size -= got;
+    }
+    return true;
+}
@@ -0,0 +1,141 @@
+// Includes standard C++ libraries and project-specific headers
+#include "../include/scrape_pool.h"
+#include "../include/news_parser.h"
+#include "../include/utils.h"
+#include <bits/stdc++.h>
+
+using namespace std;
+
+// Host part of a URL, lower-cased
+string urlDomain(const string& url)
+{
+    size_t start = url.find("://");
+    start = (start == string::npos) ? 0 : start + 3;
+    size_t end = url.find_first_of(":/?#", start);
+    string domain = url.substr(start, (end == string::npos ? url.size() : end) - start);
+
+    // Drop user info ("user@host")
+    size_t at = domain.rfind('@');
+    if (at != string::npos) domain.erase(0, at + 1);
+
+    transform(domain.begin(), domain.end(), domain.begin(), [](unsigned char c){ return char(tolower(c)); });
+    return domain;
+}
+
+// === ScrapePool ===
+
+// Starts the worker threads
+ScrapePool::ScrapePool(int workers, int perDomain, int timeoutSeconds)
+    : perDomain(max(1, perDomain)), timeoutSeconds(max(1, timeoutSeconds))
+{
+    for (int i = 0; i < max(1, workers); ++i)
+    {
+        threads.emplace_back(&ScrapePool::workerLoop, this);
+    }
+}
+
+// Drops articles not yet started, waits for the ones in progress and joins the workers
+ScrapePool::~ScrapePool()
+{
+    {
+        lock_guard<mutex> lock(stateMutex);
+        stopping = true;
+        for (auto& entry : waiting) inFlight.erase(entry.second.url);
+        waiting.clear();
+    }
+    changed.notify_all();
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+}
+
+// Queues an article for scraping; returns at once (false if its URL is already queued)
+bool ScrapePool::submit(NewsItem item)
+{
+    string domain = urlDomain(item.url);
+    {
+        lock_guard<mutex> lock(stateMutex);
+        if (!inFlight.insert(item.url).second) return false;
+        waiting.emplace_back(move(domain), move(item));
+    }
+    changed.notify_one();
+    return true;
+}
+
+// Articles queued or being scraped
+size_t ScrapePool::pending() const
+{
+    lock_guard<mutex> lock(stateMutex);
+    return waiting.size() + inProgress;
+}
+
+// Index in `waiting` of the oldest article whose site has a free slot, or -1 (stateMutex held)
+ptrdiff_t ScrapePool::nextRunnable() const
+{
+    for (size_t i = 0; i < waiting.size(); ++i)
+    {
+        auto it = active.find(waiting[i].first);
+        if (it == active.end() || it->second < perDomain) return ptrdiff_t(i);
+    }
+    return -1;
+}
+
+// Takes the next article whose site has a free slot and scrapes it, until stopping
+void ScrapePool::workerLoop()
+{
+    while (true)
+    {
+        string domain;
+        NewsItem item;
+        {
+            unique_lock<mutex> lock(stateMutex);
+            ptrdiff_t index = -1;
+            changed.wait(lock, [&]{ return stopping || (index = nextRunnable()) >= 0; });
+            if (stopping) return;
+
+            domain = move(waiting[index].first);
+            item = move(waiting[index].second);
+            waiting.erase(waiting.begin() + index);
+            ++active[domain];
+            ++inProgress;
+        }
+
+        // Try to fetch full article text from the URL using article_scraper.py
+        bool failed = false;
+        try
+        {
+            item.text = getArticleText(item.url, timeoutSeconds);
+
+            // Push the item into the global queue (waits for room, or drops, when the queue is full)
+            if (newsQueue.push(item))
+            {
+                safeCout("[INFO] ", "News article from URL: " + item.url + "\n - successfully parsed and added to queue.\n\n");
+            }
+            else
+            {
+                safeCerr("[WARN] ", "News queue full, dropped article from URL: " + item.url + "\n\n");
+            }
+        }
+        catch (const exception& e)
+        {
+            failed = true;
+
+            // Print any error that occurred
+            safeCerr("[WARN] ", "News article from URL: " + item.url + "\n - failed to be parsed and was not added to queue.\n");
+            safeCerr("[ERROR] ", string(e.what()) + "\n\n");  // print the specific error
+        }
+
+        // A failed article is forgotten, so the next poll listing it retries it
+        if (failed) seenUrls.erase(item.url);
+
+        // Free the site's slot; an article waiting on it may now run
+        {
+            lock_guard<mutex> lock(stateMutex);
+            if (--active[domain] == 0) active.erase(domain);
+            inFlight.erase(item.url);
+            --inProgress;
+        }
+        changed.notify_all();
+    }
+}
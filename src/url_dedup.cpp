@@ -0,0 +1,217 @@
+// Includes standard C++ libraries and project-specific headers
+#include "../include/url_dedup.h"
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace chrono;
+
+// Smallest power of two >= n
+static size_t roundUpPow2(size_t n)
+{
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+// === UrlDedupSet ===
+
+UrlDedupSet::UrlDedupSet(size_t capacity, seconds ttl)
+{
+    configure(capacity, ttl);
+}
+
+// Resizes and clears the set (startup only, before other threads use it)
+void UrlDedupSet::configure(size_t capacity, seconds ttl)
+{
+    shardSlots = max(roundUpPow2((capacity + shards.size() - 1) / shards.size()), PROBE_WINDOW);
+    for (Shard& shard : shards)
+    {
+        shard.keys.assign(shardSlots, 0);
+        shard.seenAt.assign(shardSlots, 0);
+    }
+    ttlSeconds = max<int64_t>(ttl.count(), 1);
+
+    filterWords = roundUpPow2(this->capacity() * BLOOM_BITS_PER_SLOT / 64);
+    for (auto& generation : filter)
+    {
+        generation.reset(new atomic<uint64_t>[filterWords]);
+        for (size_t w = 0; w < filterWords; ++w) generation[w].store(0, memory_order_relaxed);
+    }
+    current.store(0);
+    generationStart.store(now());
+}
+
+// Records a URL as seen; true if it was not seen within the last ttl
+bool UrlDedupSet::insert(string_view url, int64_t nowSeconds)
+{
+    uint64_t key = fingerprint(url);
+
+    // A URL the filter has never seen cannot be live, so the first free slot will do
+    bool known = mayContain(key);
+    if (!known) filterSkipCount.fetch_add(1, memory_order_relaxed);
+
+    Shard& shard = shardOf(key);
+    size_t mask = shardSlots - 1;
+    size_t home = size_t(key) & mask;
+    {
+        lock_guard<mutex> guard(shard.lock);
+        size_t freeSlot = SIZE_MAX;     // First empty or expired slot of the window
+        size_t oldestSlot = home;       // Eviction candidate if the window is full of live entries
+        for (size_t i = 0; i < PROBE_WINDOW; ++i)
+        {
+            size_t slot = (home + i) & mask;
+            uint64_t k = shard.keys[slot];
+            bool live = k != 0 && nowSeconds - shard.seenAt[slot] < ttlSeconds;
+
+            if (k == key)
+            {
+                if (live)
+                {
+                    duplicateCount.fetch_add(1, memory_order_relaxed);
+                    return false;
+                }
+                freeSlot = slot;        // Seen before but expired: reuse its own slot
+                break;
+            }
+            if (!live && freeSlot == SIZE_MAX)
+            {
+                freeSlot = slot;
+                if (!known) break;
+            }
+
+            // Slots are never emptied again, so an empty slot ends the probe sequence
+            if (k == 0) break;
+            if (shard.seenAt[slot] < shard.seenAt[oldestSlot]) oldestSlot = slot;
+        }
+
+        if (freeSlot == SIZE_MAX)
+        {
+            freeSlot = oldestSlot;
+            evictionCount.fetch_add(1, memory_order_relaxed);
+        }
+        shard.keys[freeSlot] = key;
+        shard.seenAt[freeSlot] = nowSeconds;
+    }
+
+    addToFilter(key, nowSeconds);
+    return true;
+}
+
+// Forgets a URL. The slot keeps its key, since an empty slot would cut the probe
+// sequence of later keys, but is marked expired so insert() reuses it.
+bool UrlDedupSet::erase(string_view url)
+{
+    uint64_t key = fingerprint(url);
+    if (!mayContain(key)) return false;
+
+    int64_t nowSeconds = now();
+    Shard& shard = shardOf(key);
+    size_t mask = shardSlots - 1;
+    size_t home = size_t(key) & mask;
+    lock_guard<mutex> guard(shard.lock);
+    for (size_t i = 0; i < PROBE_WINDOW; ++i)
+    {
+        size_t slot = (home + i) & mask;
+        uint64_t k = shard.keys[slot];
+        if (k == 0) return false;
+        if (k == key)
+        {
+            bool live = nowSeconds - shard.seenAt[slot] < ttlSeconds;
+            shard.seenAt[slot] = nowSeconds - ttlSeconds;
+            return live;
+        }
+    }
+    return false;
+}
+
+// Whether a URL was seen within the last ttl
+bool UrlDedupSet::contains(string_view url, int64_t nowSeconds) const
+{
+    uint64_t key = fingerprint(url);
+    if (!mayContain(key)) return false;
+
+    const Shard& shard = shardOf(key);
+    size_t mask = shardSlots - 1;
+    size_t home = size_t(key) & mask;
+    lock_guard<mutex> guard(shard.lock);
+    for (size_t i = 0; i < PROBE_WINDOW; ++i)
+    {
+        size_t slot = (home + i) & mask;
+        uint64_t k = shard.keys[slot];
+        if (k == 0) return false;
+        if (k == key) return nowSeconds - shard.seenAt[slot] < ttlSeconds;
+    }
+    return false;
+}
+
+// Whether the filter may contain a fingerprint
+bool UrlDedupSet::mayContain(uint64_t key) const
+{
+    for (const auto& generation : filter)
+    {
+        bool all = true;
+        for (int i = 0; i < BLOOM_HASHES && all; ++i)
+        {
+            size_t bit = filterBit(key, i);
+            all = (generation[bit / 64].load(memory_order_relaxed) >> (bit % 64)) & 1;
+        }
+        if (all) return true;
+    }
+    return false;
+}
+
+// Adds a fingerprint to the current filter generation, rotating it if it is older than ttl.
+// The generation cleared on rotation only holds URLs first seen over ttl ago, which have
+// all expired, so clearing it while other threads read it never hides a live URL.
+void UrlDedupSet::addToFilter(uint64_t key, int64_t nowSeconds)
+{
+    if (nowSeconds - generationStart.load(memory_order_acquire) >= ttlSeconds)
+    {
+        lock_guard<mutex> guard(rotateLock);
+        if (nowSeconds - generationStart.load(memory_order_relaxed) >= ttlSeconds)
+        {
+            int next = 1 - current.load(memory_order_relaxed);
+            for (size_t w = 0; w < filterWords; ++w) filter[next][w].store(0, memory_order_relaxed);
+            current.store(next, memory_order_release);
+            generationStart.store(nowSeconds, memory_order_release);
+        }
+    }
+
+    auto& generation = filter[current.load(memory_order_acquire)];
+    for (int i = 0; i < BLOOM_HASHES; ++i)
+    {
+        size_t bit = filterBit(key, i);
+        generation[bit / 64].fetch_or(uint64_t(1) << (bit % 64), memory_order_relaxed);
+    }
+}
+
+// Bit positions of a fingerprint in a filter generation (double hashing on its two halves)
+size_t UrlDedupSet::filterBit(uint64_t key, int i) const
+{
+    uint64_t h1 = key;
+    uint64_t h2 = (key >> 32) | 1;
+    return size_t(h1 + uint64_t(i) * h2) & (filterWords * 64 - 1);
+}
+
+// 64-bit fingerprint of a URL: FNV-1a, then a MurmurHash3 finalizer to spread the bits
+uint64_t UrlDedupSet::fingerprint(string_view url)
+{
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (unsigned char c : url)
+    {
+        h ^= c;
+        h *= 0x100000001b3ull;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h == 0 ? 1 : h;
+}
+
+// Seconds on the steady clock
+int64_t UrlDedupSet::now()
+{
+    return duration_cast<seconds>(steady_clock::now().time_since_epoch()).count();
+}
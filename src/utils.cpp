@@ -67,7 +67,7 @@ string getUTCTimeOffset(int secondsAgo)
 Config loadSettings(string filename)
 {
     // Create an empty Config object to hold the settings
-    Config cfg; 
+    Config cfg{};   // Value-initialized, so missing numeric keys read as 0 and fall back to their defaults
 
     // Open the specified file for reading
     ifstream file(filename); 
@@ -97,6 +97,18 @@ Config loadSettings(string filename)
         else if(key == "debug") cfg.debug = (value == "true");              // convert to bool
         else if(key == "logToFile") cfg.logToFile = (value == "true");      // convert to bool
         else if(key == "useGPU") cfg.useGPU = (value == "true");            // convert to bool
+        else if(key == "sentimentBatchSize") cfg.sentimentBatchSize = stoi(value);  // convert to int
+        else if(key == "processingWorkers") cfg.processingWorkers = stoi(value);    // convert to int
+        else if(key == "newsQueueCapacity") cfg.newsQueueCapacity = stoi(value);    // convert to int
+        else if(key == "statusQueueCapacity") cfg.statusQueueCapacity = stoi(value);    // convert to int
+        else if(key == "queueOverflowPolicy") cfg.queueOverflowPolicy = value;
+        else if(key == "scrapeWorkers") cfg.scrapeWorkers = stoi(value);    // convert to int
+        else if(key == "scrapePerDomain") cfg.scrapePerDomain = stoi(value);    // convert to int
+        else if(key == "scrapeTimeoutSeconds") cfg.scrapeTimeoutSeconds = stoi(value);  // convert to int
+        else if(key == "seenUrlCapacity") cfg.seenUrlCapacity = stoi(value);    // convert to int
+        else if(key == "seenUrlTtlHours") cfg.seenUrlTtlHours = stoi(value);    // convert to int
+        else if(key == "companyEmbeddingsFile") cfg.companyEmbeddingsFile = value;
+        else if(key == "companyIndex") cfg.companyIndex = value;
         else if(key == "pythonInterpreter") cfg.pythonInterpreter = value;
         else if(key == "marketAuxBaseApi") cfg.marketAuxBaseApi = value;
         else if(key == "astraDBApplicationToken") cfg.astraDBApplicationToken = value;